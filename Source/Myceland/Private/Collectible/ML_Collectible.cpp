@@ -5,6 +5,7 @@
 #include "Components/SphereComponent.h"
 #include "Player/ML_PlayerCharacter.h"
 #include "Player/ML_PlayerController.h"
+#include "Subsystem/ML_CollectiblePoolSubsystem.h"
 #include "Tiles/ML_Tile.h"
 
 
@@ -55,7 +56,36 @@ void AML_Collectible::AddEnergy(AML_PlayerController* MycelandController, AML_Pl
 		OwningTile->SetHasCollectible(false);
 		OwningTile = nullptr;
 	}
-	Destroy();
+
+	if (UML_CollectiblePoolSubsystem* CollectiblePool = GetWorld()->GetSubsystem<UML_CollectiblePoolSubsystem>())
+		CollectiblePool->Release(this);
+	else
+		Destroy();
+}
+
+void AML_Collectible::ActivateFromPool(const FVector& Location)
+{
+	bInPool = false;
+	PoolGeneration++;
+
+	SetActorLocationAndRotation(Location, FRotator::ZeroRotator, false, nullptr, ETeleportType::ResetPhysics);
+	SetActorHiddenInGame(false);
+	SetActorTickEnabled(true);
+	Collision->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+
+	OnActivatedFromPool();
+}
+
+void AML_Collectible::DeactivateToPool()
+{
+	bInPool = true;
+
+	Collision->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	SetActorHiddenInGame(true);
+	SetActorTickEnabled(false);
+
+	OwningTile = nullptr;
+	OwningAxial = FIntPoint::ZeroValue;
 }
 
 // bool AML_Collectible::CheckIsOwningTile(AML_PlayerCharacter* MycelandCharacter)
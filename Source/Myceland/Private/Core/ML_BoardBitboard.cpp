@@ -0,0 +1,170 @@
+﻿// Copyright Myceland Team, All Rights Reserved.
+
+
+#include "Core/ML_BoardBitboard.h"
+
+#include "Core/ML_BoardState.h"
+
+namespace
+{
+	// Out |= In << Amount (toward higher bits)
+	void ShiftUpOr(const TConstArrayView<uint64> In, const int32 Amount, const TArrayView<uint64> Out)
+	{
+		const int32 WordShift = Amount / 64;
+		const int32 BitShift = Amount % 64;
+
+		for (int32 Word = Out.Num() - 1; Word >= WordShift; --Word)
+		{
+			const int32 From = Word - WordShift;
+			uint64 Value = In[From] << BitShift;
+			if (BitShift != 0 && From > 0) Value |= In[From - 1] >> (64 - BitShift);
+			Out[Word] |= Value;
+		}
+	}
+
+	// Out |= In >> Amount (toward lower bits)
+	void ShiftDownOr(const TConstArrayView<uint64> In, const int32 Amount, const TArrayView<uint64> Out)
+	{
+		const int32 WordShift = Amount / 64;
+		const int32 BitShift = Amount % 64;
+
+		for (int32 Word = 0; Word + WordShift < Out.Num(); ++Word)
+		{
+			const int32 From = Word + WordShift;
+			uint64 Value = In[From] >> BitShift;
+			if (BitShift != 0 && From + 1 < In.Num()) Value |= In[From + 1] << (64 - BitShift);
+			Out[Word] |= Value;
+		}
+	}
+}
+
+void FML_BoardBitboard::Init(const TSharedRef<const FML_BoardLayout>& InLayout)
+{
+	Layout = InLayout;
+
+	Stride = InLayout->GetWidth() + 1;
+	NumWords = FMath::DivideAndRoundUp(Stride * InLayout->GetHeight(), BitsPerWord);
+
+	BoardMask.Init(0, NumWords);
+	for (int32 Index = 0; Index < InLayout->Num(); ++Index)
+	{
+		SetBit(BoardMask.GetData(), BitOf(Index));
+	}
+
+	TypeMasks.Init(0, NumTileTypes * NumWords);
+	if (NumWords > 0)
+	{
+		FMemory::Memcpy(TypeMasks.GetData() + static_cast<int32>(EML_TileType::Dirt) * NumWords, BoardMask.GetData(), NumWords * sizeof(FWord));
+	}
+}
+
+void FML_BoardBitboard::SetType(const int32 Index, const EML_TileType OldType, const EML_TileType NewType)
+{
+	const int32 Bit = BitOf(Index);
+	ClearBit(TypeMasks.GetData() + static_cast<int32>(OldType) * NumWords, Bit);
+	SetBit(TypeMasks.GetData() + static_cast<int32>(NewType) * NumWords, Bit);
+}
+
+int32 FML_BoardBitboard::BitOf(const int32 Index) const
+{
+	const FIntPoint Local = Layout->GetAxial(Index) - Layout->GetMinAxial();
+	return Local.Y * Stride + Local.X;
+}
+
+int32 FML_BoardBitboard::IndexOfBit(const int32 Bit) const
+{
+	const FIntPoint Local(Bit % Stride, Bit / Stride);
+	if (Local.X >= Layout->GetWidth()) return INDEX_NONE;
+
+	return Layout->IndexOf(Layout->GetMinAxial() + Local);
+}
+
+void FML_BoardBitboard::Dilate(const TConstArrayView<FWord> In, const TArrayView<FWord> Out) const
+{
+	check(In.Num() == NumWords && Out.Num() == NumWords);
+	FMemory::Memzero(Out.GetData(), NumWords * sizeof(FWord));
+
+	// Directions (1,0) (-1,0) (0,1) (0,-1) (-1,1) (1,-1)
+	ShiftUpOr(In, 1, Out);
+	ShiftDownOr(In, 1, Out);
+	ShiftUpOr(In, Stride, Out);
+	ShiftDownOr(In, Stride, Out);
+	ShiftUpOr(In, Stride - 1, Out);
+	ShiftDownOr(In, Stride - 1, Out);
+
+	for (int32 Word = 0; Word < NumWords; ++Word)
+	{
+		Out[Word] &= BoardMask[Word];
+	}
+}
+
+void FML_BoardBitboard::FloodFill(const EML_TileType SourceType, const EML_TileType IntoType, FML_BoardChangeBuckets& OutChanges) const
+{
+	FloodFill(SourceType, IntoType, BoardMask, OutChanges);
+}
+
+void FML_BoardBitboard::FloodFill(const EML_TileType SourceType, const EML_TileType IntoType, const TConstArrayView<FWord> SeedMask, FML_BoardChangeBuckets& OutChanges) const
+{
+	check(SeedMask.Num() == NumWords);
+
+	TArray<FWord> Frontier(GetTypeMask(SourceType));
+	for (int32 Word = 0; Word < NumWords; ++Word)
+	{
+		Frontier[Word] &= SeedMask[Word];
+	}
+
+	TArray<FWord> Remaining(GetTypeMask(IntoType));
+	TArray<FWord> Next;
+	Next.SetNumUninitialized(NumWords);
+
+	for (int32 Distance = 1; ; ++Distance)
+	{
+		Dilate(Frontier, Next);
+
+		bool bAnyReached = false;
+		for (int32 Word = 0; Word < NumWords; ++Word)
+		{
+			Next[Word] &= Remaining[Word];
+			Remaining[Word] &= ~Next[Word];
+			bAnyReached |= Next[Word] != 0;
+		}
+
+		if (!bAnyReached) break;
+
+		AppendChanges(Next, SourceType, Distance, OutChanges);
+		Swap(Frontier, Next);
+	}
+}
+
+void FML_BoardBitboard::MakeNeighborhoodMask(const TConstArrayView<int32> Indices, TArray<FWord>& OutMask) const
+{
+	TArray<FWord> TileMask;
+	TileMask.Init(0, NumWords);
+	for (const int32 Index : Indices)
+	{
+		if (Layout->IsValidIndex(Index)) SetBit(TileMask.GetData(), BitOf(Index));
+	}
+
+	OutMask.SetNumUninitialized(NumWords);
+	Dilate(TileMask, OutMask);
+	for (int32 Word = 0; Word < NumWords; ++Word)
+	{
+		OutMask[Word] |= TileMask[Word];
+	}
+}
+
+void FML_BoardBitboard::AppendChanges(const TConstArrayView<FWord> Mask, const EML_TileType TargetType, const int32 Distance, FML_BoardChangeBuckets& OutChanges) const
+{
+	for (int32 Word = 0; Word < Mask.Num(); ++Word)
+	{
+		FWord Bits = Mask[Word];
+		while (Bits != 0)
+		{
+			const int32 Bit = Word * BitsPerWord + static_cast<int32>(FMath::CountTrailingZeros64(Bits));
+			Bits &= Bits - 1;
+
+			const int32 Index = IndexOfBit(Bit);
+			if (Index != INDEX_NONE) OutChanges.Add(FML_BoardChange(Index, TargetType, Distance));
+		}
+	}
+}
@@ -0,0 +1,63 @@
+﻿// Copyright Myceland Team, All Rights Reserved.
+
+
+#include "Core/ML_BoardLayout.h"
+
+#include "Core/ML_CoreData.h"
+
+void FML_BoardLayout::Build(const TConstArrayView<FIntPoint> InAxials)
+{
+	Reset();
+	if (InAxials.Num() == 0) return;
+
+	Axials.Append(InAxials.GetData(), InAxials.Num());
+	Axials.Sort([](const FIntPoint& A, const FIntPoint& B)
+	{
+		return A.Y != B.Y ? A.Y < B.Y : A.X < B.X;
+	});
+
+	FIntPoint MaxAxial = Axials[0];
+	MinAxial = Axials[0];
+	for (const FIntPoint& Axial : Axials)
+	{
+		MinAxial = MinAxial.ComponentMin(Axial);
+		MaxAxial = MaxAxial.ComponentMax(Axial);
+	}
+
+	Width = MaxAxial.X - MinAxial.X + 1;
+	Height = MaxAxial.Y - MinAxial.Y + 1;
+
+	CellToIndex.Init(INDEX_NONE, Width * Height);
+	for (int32 Index = 0; Index < Axials.Num(); ++Index)
+	{
+		const FIntPoint Local = Axials[Index] - MinAxial;
+		CellToIndex[Local.Y * Width + Local.X] = Index;
+	}
+
+	NeighborTable.SetNumUninitialized(Axials.Num() * NumNeighbors);
+	for (int32 Index = 0; Index < Axials.Num(); ++Index)
+	{
+		for (int32 Dir = 0; Dir < NumNeighbors; ++Dir)
+		{
+			NeighborTable[Index * NumNeighbors + Dir] = IndexOf(Axials[Index] + Directions[Dir]);
+		}
+	}
+}
+
+void FML_BoardLayout::Reset()
+{
+	Axials.Reset();
+	NeighborTable.Reset();
+	CellToIndex.Reset();
+	MinAxial = FIntPoint::ZeroValue;
+	Width = 0;
+	Height = 0;
+}
+
+int32 FML_BoardLayout::IndexOf(const FIntPoint& Axial) const
+{
+	const FIntPoint Local = Axial - MinAxial;
+	if (Local.X < 0 || Local.Y < 0 || Local.X >= Width || Local.Y >= Height) return INDEX_NONE;
+
+	return CellToIndex[Local.Y * Width + Local.X];
+}
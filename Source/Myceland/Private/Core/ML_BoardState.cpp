@@ -0,0 +1,97 @@
+﻿// Copyright Myceland Team, All Rights Reserved.
+
+
+#include "Core/ML_BoardState.h"
+
+#include "Core/ML_Zobrist.h"
+
+void FML_BoardState::Init(const TSharedRef<const FML_BoardLayout>& InLayout)
+{
+	Layout = InLayout;
+
+	const int32 NumTiles = InLayout->Num();
+	Types.Init(EML_TileType::Dirt, NumTiles);
+	Bitboard.Init(InLayout);
+	WaterComponents.Reset(NumTiles);
+	Collectibles.Init(false, NumTiles);
+	ConsumedGrass.Init(false, NumTiles);
+
+	Hash = 0;
+	for (int32 Index = 0; Index < NumTiles; ++Index)
+	{
+		Hash ^= FML_Zobrist::TypeKey(Index, EML_TileType::Dirt);
+	}
+
+	ResetJournal();
+}
+
+void FML_BoardState::SetType(const int32 Index, const EML_TileType NewType)
+{
+	if (Types[Index] == NewType) return;
+
+	const EML_TileType OldType = Types[Index];
+	Bitboard.SetType(Index, OldType, NewType);
+	Types[Index] = NewType;
+	Hash ^= FML_Zobrist::TypeKey(Index, OldType) ^ FML_Zobrist::TypeKey(Index, NewType);
+	RecordChange(Index);
+
+	// Merging is incremental, a split needs new labels
+	if (NewType == EML_TileType::Water)
+		WaterComponents.AddWater(*Layout, Types, Index);
+	else if (OldType == EML_TileType::Water)
+		WaterComponents.Rebuild(*Layout, Types);
+}
+
+void FML_BoardState::SetHasCollectible(const int32 Index, const bool bNewValue)
+{
+	if (Collectibles[Index] == bNewValue) return;
+
+	Collectibles[Index] = bNewValue;
+	Hash ^= FML_Zobrist::CollectibleKey(Index);
+	RecordChange(Index);
+}
+
+bool FML_BoardState::GetChangesSince(const uint32 Serial, TConstArrayView<int32>& OutChangedTiles) const
+{
+	if (Serial < JournalBase || Serial > GetChangeSerial()) return false;
+
+	OutChangedTiles = TConstArrayView<int32>(ChangeJournal).RightChop(Serial - JournalBase);
+	return true;
+}
+
+void FML_BoardState::RecordChange(const int32 Index)
+{
+	// Past a few full boards of changes, reading the journal costs more than a full scan
+	if (ChangeJournal.Num() >= 4 * Num() + 64)
+	{
+		ResetJournal();
+	}
+
+	ChangeJournal.Add(Index);
+}
+
+void FML_BoardState::ResetJournal()
+{
+	JournalBase = GetChangeSerial() + 1;
+	ChangeJournal.Reset();
+}
+
+bool FML_BoardState::ApplyChange(const FML_BoardChange& Change)
+{
+	if (!IsValidIndex(Change.TileIndex)) return false;
+
+	if (Change.bSpawnCollectible)
+	{
+		if (HasCollectible(Change.TileIndex)) return false;
+
+		SetHasCollectible(Change.TileIndex, true);
+		return true;
+	}
+
+	const EML_TileType OldType = GetType(Change.TileIndex);
+	if (OldType == Change.TargetType) return false;
+
+	SetType(Change.TileIndex, Change.TargetType);
+	SetConsumedGrass(Change.TileIndex, OldType == EML_TileType::Grass && Change.TargetType == EML_TileType::Parasite);
+	return true;
+}
@@ -0,0 +1,46 @@
+﻿// Copyright Myceland Team, All Rights Reserved.
+
+
+#include "Core/ML_WaterComponents.h"
+
+void FML_WaterComponents::Reset(const int32 NumTiles)
+{
+	Parents.Init(INDEX_NONE, NumTiles);
+	Sizes.Init(0, NumTiles);
+}
+
+void FML_WaterComponents::Rebuild(const FML_BoardLayout& Layout, const TConstArrayView<EML_TileType> Types)
+{
+	Reset(Types.Num());
+
+	for (int32 Index = 0; Index < Types.Num(); ++Index)
+	{
+		if (Types[Index] == EML_TileType::Water) AddWater(Layout, Types, Index);
+	}
+}
+
+void FML_WaterComponents::AddWater(const FML_BoardLayout& Layout, const TConstArrayView<EML_TileType> Types, const int32 Index)
+{
+	if (Parents[Index] != INDEX_NONE) return;
+
+	Parents[Index] = Index;
+	Sizes[Index] = 1;
+
+	for (const int32 NeighborIndex : Layout.GetNeighborIndices(Index))
+	{
+		if (NeighborIndex != INDEX_NONE && Parents[NeighborIndex] != INDEX_NONE) Union(Index, NeighborIndex);
+	}
+}
+
+void FML_WaterComponents::Union(const int32 A, const int32 B)
+{
+	int32 RootA = GetComponent(A);
+	int32 RootB = GetComponent(B);
+	if (RootA == RootB) return;
+
+	// Smaller body under the bigger one keeps the trees logarithmic
+	if (Sizes[RootA] < Sizes[RootB]) Swap(RootA, RootB);
+
+	Parents[RootB] = RootA;
+	Sizes[RootA] += Sizes[RootB];
+}
@@ -0,0 +1,153 @@
+﻿// Copyright Myceland Team, All Rights Reserved.
+
+
+#include "Core/ML_WaveRuleEngine.h"
+
+#include "Core/ML_BoardState.h"
+#include "Core/ML_HexBFS.h"
+
+#include <atomic>
+
+namespace
+{
+	struct FWaveRulePolicy : FML_HexBFSPolicy
+	{
+		const FML_CompiledWaveRules& Rules;
+		const FML_BoardState& State;
+		const FML_HexBFSScratch& Scratch;
+
+		// Type of every tile during the run, converted tiles spread with their result
+		TArray<EML_TileType>& WaveTypes;
+
+		// Indexed by water component (FML_BoardState::GetWaterComponent), empty when no rule needs it
+		TBitArray<>& WaterConnected;
+
+		FML_BoardChangeBuckets& OutChanges;
+
+		FWaveRulePolicy(const FML_CompiledWaveRules& InRules, const FML_BoardState& InState, const FML_HexBFSScratch& InScratch,
+		                TArray<EML_TileType>& InWaveTypes, TBitArray<>& InWaterConnected, FML_BoardChangeBuckets& InOutChanges)
+			: Rules(InRules), State(InState), Scratch(InScratch), WaveTypes(InWaveTypes), WaterConnected(InWaterConnected), OutChanges(InOutChanges) {}
+
+		void ConnectWaterAround(const int32 Index) const
+		{
+			for (const int32 NeighborIndex : State.GetNeighbors(Index))
+			{
+				const int32 Component = NeighborIndex != INDEX_NONE ? State.GetWaterComponent(NeighborIndex) : INDEX_NONE;
+				if (Component != INDEX_NONE) WaterConnected[Component] = true;
+			}
+		}
+
+		bool TouchesConnectedWater(const int32 Index) const
+		{
+			for (const int32 NeighborIndex : State.GetNeighbors(Index))
+			{
+				const int32 Component = NeighborIndex != INDEX_NONE ? State.GetWaterComponent(NeighborIndex) : INDEX_NONE;
+				if (Component != INDEX_NONE && WaterConnected[Component]) return true;
+			}
+			return false;
+		}
+
+		bool CanEnter(const int32 FromIndex, const int32 ToIndex) const
+		{
+			const FML_CompiledWaveRules::FPairRule& Rule = Rules.GetPairRule(WaveTypes[FromIndex], WaveTypes[ToIndex]);
+			if (!Rule.bValid) return false;
+
+			return Rule.Condition != EML_WaveRuleCondition::TouchesConnectedWater || TouchesConnectedWater(ToIndex);
+		}
+
+		EML_HexBFSVisit OnVisit(const int32 Index, const int32 Distance)
+		{
+			if (Distance == 0) return EML_HexBFSVisit::Expand;
+
+			const FML_CompiledWaveRules::FPairRule& Rule = Rules.GetPairRule(WaveTypes[Scratch.GetParent(Index)], WaveTypes[Index]);
+			WaveTypes[Index] = Rule.Result;
+			OutChanges.Add(FML_BoardChange(Index, Rule.Result, Distance));
+
+			if (WaterConnected.Num() > 0 && Rules.IsWaterSource(Rule.Result)) ConnectWaterAround(Index);
+
+			return Rule.Propagation == EML_WaveRulePropagation::Flood ? EML_HexBFSVisit::Expand : EML_HexBFSVisit::Skip;
+		}
+	};
+}
+
+FML_CompiledWaveRules FML_CompiledWaveRules::Compile(const TConstArrayView<FML_WaveRule> Rules)
+{
+	// Rule sets may load (PostLoad) off the game thread
+	static std::atomic<uint32> NextVersion = 0;
+
+	FML_CompiledWaveRules Compiled;
+	Compiled.Version = ++NextVersion;
+	int32 NumPairs = 0;
+
+	for (const FML_WaveRule& Rule : Rules)
+	{
+		if (Rule.SourceType == Rule.VictimType || Rule.VictimType == Rule.ResultType) continue;
+
+		FPairRule& Pair = Compiled.Pairs[static_cast<int32>(Rule.SourceType) * NumTypes + static_cast<int32>(Rule.VictimType)];
+		if (Pair.bValid)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Wave rules: %s -> %s has several rules, only the first one is kept"),
+			       *UEnum::GetValueAsString(Rule.SourceType), *UEnum::GetValueAsString(Rule.VictimType));
+			continue;
+		}
+
+		Pair.bValid = true;
+		Pair.Result = Rule.ResultType;
+		Pair.Condition = Rule.Condition;
+		Pair.Propagation = Rule.Propagation;
+
+		Compiled.SourceMask |= 1u << static_cast<uint32>(Rule.SourceType);
+		if (Rule.Condition == EML_WaveRuleCondition::TouchesConnectedWater)
+			Compiled.WaterSourceMask |= 1u << static_cast<uint32>(Rule.SourceType);
+		++NumPairs;
+
+		Compiled.FloodSource = Rule.SourceType;
+		Compiled.FloodVictim = Rule.VictimType;
+	}
+
+	const FPairRule& Lone = Compiled.GetPairRule(Compiled.FloodSource, Compiled.FloodVictim);
+	Compiled.bBitboardFlood = NumPairs == 1 && Lone.Result == Compiled.FloodSource
+		&& Lone.Condition == EML_WaveRuleCondition::None && Lone.Propagation == EML_WaveRulePropagation::Flood;
+
+	return Compiled;
+}
+
+void FML_CompiledWaveRules::Execute(const FML_BoardState& State, FML_BoardChangeBuckets& OutChanges) const
+{
+	if (IsEmpty() || State.Num() == 0) return;
+
+	if (bBitboardFlood)
+	{
+		State.GetBitboard().FloodFill(FloodSource, FloodVictim, OutChanges);
+		return;
+	}
+
+	thread_local FML_HexBFSScratch Scratch;
+	thread_local TArray<EML_TileType> WaveTypes;
+	thread_local TArray<int32> Sources;
+
+	WaveTypes.SetNumUninitialized(State.Num());
+	Sources.Reset();
+	for (int32 Index = 0; Index < State.Num(); ++Index)
+	{
+		WaveTypes[Index] = State.GetType(Index);
+		if (SourceMask & (1u << static_cast<uint32>(WaveTypes[Index]))) Sources.Add(Index);
+	}
+
+	if (Sources.Num() == 0) return;
+
+	TBitArray<> WaterConnected;
+	FWaveRulePolicy Policy(*this, State, Scratch, WaveTypes, WaterConnected, OutChanges);
+
+	// Water touching the sources of water rules starts connected, the network grows with every tile converted into one
+	if (WaterSourceMask != 0)
+	{
+		WaterConnected.Init(false, State.Num());
+		for (const int32 Source : Sources)
+		{
+			if (IsWaterSource(WaveTypes[Source])) Policy.ConnectWaterAround(Source);
+		}
+	}
+
+	FML_HexBFS::Run(State.GetLayout(), Sources, Policy, Scratch);
+}
@@ -19,3 +19,21 @@ TSubclassOf<AML_TileBase> UML_BiomeTileSet::GetClassFromTileType(EML_TileType Ty
 		default: return DirtClass;
 	}
 }
+
+const UStaticMeshComponent* UML_BiomeTileSet::GetGroundTemplate(const EML_TileType Type) const
+{
+	TSubclassOf<AML_TileBase> Class;
+	switch(Type)
+	{
+		case EML_TileType::Dirt: Class = DirtClass; break;
+		case EML_TileType::Grass: Class = GrassClass; break;
+		case EML_TileType::Parasite: Class = ParasiteClass; break;
+		case EML_TileType::Water: Class = WaterClass; break;
+		default: return nullptr;
+	}
+
+	if (!Class) return nullptr;
+
+	const UStaticMeshComponent* GroundBase = Class->GetDefaultObject<AML_TileBase>()->GetGroundBase();
+	return GroundBase && GroundBase->GetStaticMesh() ? GroundBase : nullptr;
+}
@@ -0,0 +1,25 @@
+﻿// Copyright Myceland Team, All Rights Reserved.
+
+
+#include "Data Asset/ML_WaveRuleSet.h"
+
+void UML_WaveRuleSet::CompileRules()
+{
+	CompiledRules = MakeShared<FML_CompiledWaveRules, ESPMode::ThreadSafe>(FML_CompiledWaveRules::Compile(Rules));
+}
+
+void UML_WaveRuleSet::PostLoad()
+{
+	Super::PostLoad();
+
+	CompileRules();
+}
+
+#if WITH_EDITOR
+void UML_WaveRuleSet::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	CompileRules();
+}
+#endif
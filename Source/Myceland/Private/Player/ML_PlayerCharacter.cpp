@@ -8,6 +8,8 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "Player/ML_PlayerController.h"
+#include "Subsystem/ML_BoardRegistrySubsystem.h"
+#include "Tiles/ML_BoardSpawner.h"
 #include "Tiles/ML_Tile.h"
 
 
@@ -41,41 +43,20 @@ AML_PlayerCharacter::AML_PlayerCharacter()
 
 void AML_PlayerCharacter::UpdateCurrentTile()
 {
-	const FVector ActorLocation = GetActorLocation();
-
-	float CapsuleRadius;
-	float CapsuleHalfHeight;
-	GetCapsuleComponent()->GetScaledCapsuleSize(CapsuleRadius, CapsuleHalfHeight);
-
-	FVector Start = ActorLocation;
-	FVector End = ActorLocation;
-	End.Z = (ActorLocation.Z - (CapsuleHalfHeight - 10.f)) - 20.f;
-
-	FHitResult Hit;
-	FCollisionQueryParams Params;
-	Params.AddIgnoredActor(this);
-	Params.bTraceComplex = false;
-
-	bool bHit = GetWorld()->LineTraceSingleByChannel(
-		Hit,
-		Start,
-		End,
-		ECC_Visibility,
-		Params
-	);
-
 	AML_Tile* OldTile = CurrentTileOn;
-	AML_Tile* NewTile = nullptr;
+	AML_Tile* NewTile = FindTileOnBoards();
 
-	if (bHit)
-		NewTile = Cast<AML_Tile>(Hit.GetActor());
+	// Off every board (or between two of them): fall back on the physics
+	if (!NewTile)
+		NewTile = TraceTileBelow();
 
 	if (NewTile == OldTile)
 		return;
 
 	if (CurrentTileOn)
 	{
-		for (AML_Tile* Neighbor : CurrentTileOn->GetBoardSpawnerFromTile()->GetNeighbors(CurrentTileOn))
+		const FML_BoardView BoardView = CurrentTileOn->GetBoardSpawnerFromTile()->GetBoardView();
+		for (AML_Tile* Neighbor : BoardView.Neighbors(CurrentTileOn->GetBoardIndex()))
 		{
 			if (Neighbor)
 				Neighbor->StopGlowing();
@@ -87,7 +68,8 @@ void AML_PlayerCharacter::UpdateCurrentTile()
 
 	if (CurrentTileOn)
 	{
-		for (AML_Tile* Neighbor : CurrentTileOn->GetBoardSpawnerFromTile()->GetNeighbors(CurrentTileOn))
+		const FML_BoardView BoardView = CurrentTileOn->GetBoardSpawnerFromTile()->GetBoardView();
+		for (AML_Tile* Neighbor : BoardView.Neighbors(CurrentTileOn->GetBoardIndex()))
 		{
 			if (Neighbor &&
 				Neighbor->IsBlocked() == false &&
@@ -97,6 +79,66 @@ void AML_PlayerCharacter::UpdateCurrentTile()
 	}
 }
 
+AML_Tile* AML_PlayerCharacter::FindTileOnBoards() const
+{
+	// The trace only reaches the floor under the capsule, so airborne characters are not on a tile
+	if (!GetCharacterMovement()->IsMovingOnGround())
+		return nullptr;
+
+	const FVector ActorLocation = GetActorLocation();
+
+	// Current board first, the character rarely changes board
+	const AML_BoardSpawner* CurrentBoard = CurrentTileOn ? CurrentTileOn->GetBoardSpawnerFromTile() : nullptr;
+	if (CurrentBoard)
+	{
+		if (AML_Tile* Tile = CurrentBoard->GetTileAtLocation(ActorLocation))
+			return Tile;
+	}
+
+	const UML_BoardRegistrySubsystem* Registry = GetWorld()->GetSubsystem<UML_BoardRegistrySubsystem>();
+	if (!Registry)
+		return nullptr;
+
+	for (const AML_BoardSpawner* Board : Registry->GetBoards())
+	{
+		if (Board == CurrentBoard || !Board->IsBoardReady())
+			continue;
+
+		if (AML_Tile* Tile = Board->GetTileAtLocation(ActorLocation))
+			return Tile;
+	}
+
+	return nullptr;
+}
+
+AML_Tile* AML_PlayerCharacter::TraceTileBelow() const
+{
+	const FVector ActorLocation = GetActorLocation();
+
+	float CapsuleRadius;
+	float CapsuleHalfHeight;
+	GetCapsuleComponent()->GetScaledCapsuleSize(CapsuleRadius, CapsuleHalfHeight);
+
+	FVector Start = ActorLocation;
+	FVector End = ActorLocation;
+	End.Z = (ActorLocation.Z - (CapsuleHalfHeight - 10.f)) - 20.f;
+
+	FHitResult Hit;
+	FCollisionQueryParams Params;
+	Params.AddIgnoredActor(this);
+	Params.bTraceComplex = false;
+
+	bool bHit = GetWorld()->LineTraceSingleByChannel(
+		Hit,
+		Start,
+		End,
+		ECC_Visibility,
+		Params
+	);
+
+	return bHit ? AML_Tile::FromHitResult(Hit) : nullptr;
+}
+
 void AML_PlayerCharacter::HandleTileStateChange(const AML_Tile* OldTile, const AML_Tile* NewTile) const
 {
 	const bool bWasNull = (OldTile == nullptr);
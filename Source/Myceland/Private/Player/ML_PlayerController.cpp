@@ -18,25 +18,7 @@ AML_Tile* AML_PlayerController::GetTileUnderCursor() const
 	if (!GetHitResultUnderCursorByChannel(UEngineTypes::ConvertToTraceType(ECC_Visibility), true, Hit))
 		return nullptr;
 
-	if (AML_Tile* Tile = Cast<AML_Tile>(Hit.GetActor()))
-		return Tile;
-
-	if (UPrimitiveComponent* Comp = Hit.GetComponent())
-		if (AML_Tile* OuterTile = Comp->GetTypedOuter<AML_Tile>())
-			return OuterTile;
-
-	if (AActor* HitActor = Hit.GetActor())
-	{
-		if (AActor* Parent = HitActor->GetParentActor())
-			if (AML_Tile* ParentTile = Cast<AML_Tile>(Parent))
-				return ParentTile;
-
-		if (AActor* Owning = HitActor->GetOwner())
-			if (AML_Tile* OwnerTile = Cast<AML_Tile>(Owning))
-				return OwnerTile;
-	}
-
-	return nullptr;
+	return AML_Tile::FromHitResult(Hit);
 }
 
 bool AML_PlayerController::IsTileWalkable(const AML_Tile* Tile) const
@@ -47,14 +29,13 @@ bool AML_PlayerController::IsTileWalkable(const AML_Tile* Tile) const
 	return (Type == EML_TileType::Dirt || Type == EML_TileType::Grass) && !Tile->IsBlocked();
 }
 
-AML_Tile* AML_PlayerController::FindNearestWalkableTile(const FVector& WorldLocation, const TMap<FIntPoint, AML_Tile*>& GridMap) const
+AML_Tile* AML_PlayerController::FindNearestWalkableTile(const FVector& WorldLocation, const FML_BoardView& BoardView) const
 {
 	AML_Tile* Best = nullptr;
 	float BestDistSq = FLT_MAX;
 
-	for (const TPair<FIntPoint, AML_Tile*>& Pair : GridMap)
+	for (AML_Tile* Tile : BoardView)
 	{
-		AML_Tile* Tile = Pair.Value;
 		if (!IsValid(Tile) || !IsTileWalkable(Tile))
 			continue;
 
@@ -71,7 +52,7 @@ AML_Tile* AML_PlayerController::FindNearestWalkableTile(const FVector& WorldLoca
 
 // ==================== Pathfinding ====================
 
-bool AML_PlayerController::BuildPath_AxialBFS(const FIntPoint& StartAxial, const FIntPoint& GoalAxial, const TMap<FIntPoint, AML_Tile*>& GridMap, TArray<FIntPoint>& OutAxialPath) const
+bool AML_PlayerController::BuildPath_AxialBFS(const FIntPoint& StartAxial, const FIntPoint& GoalAxial, const FML_BoardView& BoardView, TArray<FIntPoint>& OutAxialPath) const
 {
 	OutAxialPath.Reset();
 
@@ -81,66 +62,51 @@ bool AML_PlayerController::BuildPath_AxialBFS(const FIntPoint& StartAxial, const
 		return true;
 	}
 
-	TArray<FIntPoint> Queue;
-	Queue.Reserve(GridMap.Num());
-	int32 Head = 0;
-
-	TMap<FIntPoint, FIntPoint> CameFrom;
-	CameFrom.Reserve(GridMap.Num());
-
-	Queue.Add(StartAxial);
-	CameFrom.Add(StartAxial, StartAxial);
+	const int32 StartIndex = BoardView.IndexOf(StartAxial);
+	const int32 GoalIndex = BoardView.IndexOf(GoalAxial);
+	if (StartIndex == INDEX_NONE || GoalIndex == INDEX_NONE)
+		return false;
 
-	while (Head < Queue.Num())
+	struct FPathPolicy : FML_HexBFSPolicy
 	{
-		const FIntPoint Current = Queue[Head++];
+		const AML_PlayerController& Controller;
+		const FML_BoardView& BoardView;
+		int32 GoalIndex;
 
-		for (const FIntPoint& Dir : Directions)
-		{
-			const FIntPoint Next = Current + Dir;
+		FPathPolicy(const AML_PlayerController& InController, const FML_BoardView& InBoardView, const int32 InGoalIndex)
+			: Controller(InController), BoardView(InBoardView), GoalIndex(InGoalIndex) {}
 
-			if (CameFrom.Contains(Next))
-				continue;
+		bool CanEnter(const int32 FromIndex, const int32 ToIndex) const { return Controller.IsTileWalkable(BoardView.GetTile(ToIndex)); }
+		EML_HexBFSVisit OnVisit(const int32 Index, const int32 Distance) const { return Index == GoalIndex ? EML_HexBFSVisit::Stop : EML_HexBFSVisit::Expand; }
+	};
 
-			const AML_Tile* const* NextTilePtr = GridMap.Find(Next);
-			if (!NextTilePtr || !IsTileWalkable(*NextTilePtr))
-				continue;
+	FPathPolicy Policy(*this, BoardView, GoalIndex);
+	if (FML_HexBFS::Run(BoardView.GetLayout(), StartIndex, Policy, PathScratch) != GoalIndex)
+		return false;
 
-			CameFrom.Add(Next, Current);
+	TArray<int32> IndexPath;
+	PathScratch.GetPathTo(GoalIndex, IndexPath);
 
-			if (Next == GoalAxial)
-			{
-				FIntPoint Step = GoalAxial;
-				while (Step != StartAxial)
-				{
-					OutAxialPath.Add(Step);
-					Step = CameFrom[Step];
-				}
-				OutAxialPath.Add(StartAxial);
-				Algo::Reverse(OutAxialPath);
-				return true;
-			}
+	OutAxialPath.Reserve(IndexPath.Num());
+	for (const int32 Index : IndexPath)
+		OutAxialPath.Add(BoardView.GetAxial(Index));
 
-			Queue.Add(Next);
-		}
-	}
-
-	return false;
+	return true;
 }
 
 
 // ==================== Movement ====================
 
-void AML_PlayerController::StartMoveAlongPath(const TArray<FIntPoint>& AxialPath, const TMap<FIntPoint, AML_Tile*>& GridMap)
+void AML_PlayerController::StartMoveAlongPath(const TArray<FIntPoint>& AxialPath, const FML_BoardView& BoardView)
 {
 	CurrentPathWorld.Reset();
 	CurrentPathIndex = 0;
 	CurrentPathWorld.Reserve(AxialPath.Num());
 
 	for (const FIntPoint& Axial : AxialPath)
-		if (AML_Tile* const* TilePtr = GridMap.Find(Axial))
-			if (IsValid(*TilePtr))
-				CurrentPathWorld.Add((*TilePtr)->GetActorLocation());
+		if (const AML_Tile* Tile = BoardView.Find(Axial))
+			if (IsValid(Tile))
+				CurrentPathWorld.Add(Tile->GetActorLocation());
 
 	if (APawn* P = GetPawn())
 		if (CurrentPathWorld.Num() > 0)
@@ -307,17 +273,17 @@ void AML_PlayerController::OnPathFinished()
 
 		if (!IsValid(TargetTile) || TargetTile->GetOwner() != Board) return;
 
-		const TMap<FIntPoint, AML_Tile*> GridMap = Board->GetGridMap();
+		const FML_BoardView BoardView = Board->GetBoardView();
 		const FIntPoint StartAxial = MycelandCharacter->CurrentTileOn->GetAxialCoord();
 		const FIntPoint GoalAxial  = TargetTile->GetAxialCoord();
 
-		if (!GridMap.Contains(StartAxial) || !GridMap.Contains(GoalAxial)) return;
-		if (!IsTileWalkable(GridMap[StartAxial]) || !IsTileWalkable(GridMap[GoalAxial])) return;
+		if (!BoardView.Contains(StartAxial) || !BoardView.Contains(GoalAxial)) return;
+		if (!IsTileWalkable(BoardView.Find(StartAxial)) || !IsTileWalkable(BoardView.Find(GoalAxial))) return;
 
 		TArray<FIntPoint> AxialPath;
-		if (!BuildPath_AxialBFS(StartAxial, GoalAxial, GridMap, AxialPath)) return;
+		if (!BuildPath_AxialBFS(StartAxial, GoalAxial, BoardView, AxialPath)) return;
 
-		StartMoveAlongPath(AxialPath, GridMap);
+		StartMoveAlongPath(AxialPath, BoardView);
 		bIsMoving = true;
 	}
 	
@@ -383,21 +349,21 @@ void AML_PlayerController::ConfirmExitBoard()
 	AML_BoardSpawner* Board = MycelandCharacter->CurrentTileOn->GetBoardSpawnerFromTile();
 	if (!IsValid(Board)) return;
 
-	const TMap<FIntPoint, AML_Tile*> GridMap = Board->GetGridMap();
+	const FML_BoardView BoardView = Board->GetBoardView();
 	const FIntPoint StartAxial = MycelandCharacter->CurrentTileOn->GetAxialCoord();
 	const FIntPoint GoalAxial  = PendingExitTile->GetAxialCoord();
 
-	if (!GridMap.Contains(StartAxial) || !GridMap.Contains(GoalAxial)) return;
+	if (!BoardView.Contains(StartAxial) || !BoardView.Contains(GoalAxial)) return;
 
 	TArray<FIntPoint> AxialPath;
-	if (!BuildPath_AxialBFS(StartAxial, GoalAxial, GridMap, AxialPath)) return;
+	if (!BuildPath_AxialBFS(StartAxial, GoalAxial, BoardView, AxialPath)) return;
 
 	// Still in board mode during this walk; FreeMovement triggers on arrival
 	CurrentMovementMode = EML_PlayerMovementMode::InsideBoard;
 	bPendingFreeMovementOnArrival = true;
 	PendingExitTile = nullptr;
 
-	StartMoveAlongPath(AxialPath, GridMap);
+	StartMoveAlongPath(AxialPath, BoardView);
 	bIsMoving = true;
 }
 
@@ -478,7 +444,7 @@ void AML_PlayerController::OnSetDestinationStarted()
 		AML_BoardSpawner* Board = MycelandCharacter->CurrentTileOn->GetBoardSpawnerFromTile();
 		if (!IsValid(Board)) return;
 
-		const TMap<FIntPoint, AML_Tile*> GridMap = Board->GetGridMap();
+		const FML_BoardView BoardView = Board->GetBoardView();
 		AML_Tile* TargetTile = GetTileUnderCursor();
 
 		// Click inside the board → BFS
@@ -487,11 +453,11 @@ void AML_PlayerController::OnSetDestinationStarted()
 			const FIntPoint StartAxial = MycelandCharacter->CurrentTileOn->GetAxialCoord();
 			const FIntPoint GoalAxial  = TargetTile->GetAxialCoord();
 
-			if (!GridMap.Contains(StartAxial) || !GridMap.Contains(GoalAxial)) return;
-			if (!IsTileWalkable(GridMap[StartAxial]) || !IsTileWalkable(GridMap[GoalAxial])) return;
+			if (!BoardView.Contains(StartAxial) || !BoardView.Contains(GoalAxial)) return;
+			if (!IsTileWalkable(BoardView.Find(StartAxial)) || !IsTileWalkable(BoardView.Find(GoalAxial))) return;
 
 			TArray<FIntPoint> AxialPath;
-			if (!BuildPath_AxialBFS(StartAxial, GoalAxial, GridMap, AxialPath)) return;
+			if (!BuildPath_AxialBFS(StartAxial, GoalAxial, BoardView, AxialPath)) return;
 
 			// --- Arm move recording (NORMAL board move) ---
 			bMoveInProgress = true;
@@ -509,7 +475,7 @@ void AML_PlayerController::OnSetDestinationStarted()
 			ActiveMovePickedCollectibles.Reset();
 			// ---------------------------------------------
 
-			StartMoveAlongPath(AxialPath, GridMap);
+			StartMoveAlongPath(AxialPath, BoardView);
 			bIsMoving = true;
 			return;
 		}
@@ -518,7 +484,7 @@ void AML_PlayerController::OnSetDestinationStarted()
 		FHitResult Hit;
 		if (!GetHitResultUnderCursorByChannel(UEngineTypes::ConvertToTraceType(ECC_Visibility), true, Hit)) return;
 
-		AML_Tile* NearestTile = FindNearestWalkableTile(Hit.Location, GridMap);
+		AML_Tile* NearestTile = FindNearestWalkableTile(Hit.Location, BoardView);
 		if (!IsValid(NearestTile)) return;
 
 		PendingExitTile = NearestTile;
@@ -581,7 +547,7 @@ void AML_PlayerController::OnMoveAndPlantStarted()
 	AML_BoardSpawner* Board = MycelandCharacter->CurrentTileOn->GetBoardSpawnerFromTile();
 	if (!IsValid(Board)) return;
 
-	const TMap<FIntPoint, AML_Tile*> GridMap = Board->GetGridMap();
+	const FML_BoardView BoardView = Board->GetBoardView();
 	AML_Tile* TargetTile = GetTileUnderCursor();
 
 	// Must click on a valid tile in the same board
@@ -593,7 +559,7 @@ void AML_PlayerController::OnMoveAndPlantStarted()
 	const FIntPoint StartAxial = MycelandCharacter->CurrentTileOn->GetAxialCoord();
 	const FIntPoint TargetAxial = TargetTile->GetAxialCoord();
 
-	if (!GridMap.Contains(StartAxial) || !GridMap.Contains(TargetAxial)) return;
+	if (!BoardView.Contains(StartAxial) || !BoardView.Contains(TargetAxial)) return;
 
 	// Check if target is already a neighbor (adjacent)
 	TArray<AML_Tile*> CurrentNeighbors = Board->GetNeighbors(MycelandCharacter->CurrentTileOn);
@@ -607,7 +573,7 @@ void AML_PlayerController::OnMoveAndPlantStarted()
 	// Target is NOT adjacent → need to path there
 	// Build full path to target
 	TArray<FIntPoint> FullPath;
-	if (!BuildPath_AxialBFS(StartAxial, TargetAxial, GridMap, FullPath)) return;
+	if (!BuildPath_AxialBFS(StartAxial, TargetAxial, BoardView, FullPath)) return;
 
 	// Need at least 2 tiles in path (start + at least one step)
 	if (FullPath.Num() < 2) return;
@@ -617,10 +583,10 @@ void AML_PlayerController::OnMoveAndPlantStarted()
 
 	// Verify the new end position is walkable
 	const FIntPoint StopAxial = FullPath.Last();
-	if (!GridMap.Contains(StopAxial) || !IsTileWalkable(GridMap[StopAxial])) return;
+	if (!BoardView.Contains(StopAxial) || !IsTileWalkable(BoardView.Find(StopAxial))) return;
 
 	// Verify that from the stop position, target is a neighbor
-	AML_Tile* StopTile = GridMap[StopAxial];
+	AML_Tile* StopTile = BoardView.Find(StopAxial);
 	TArray<AML_Tile*> StopNeighbors = Board->GetNeighbors(StopTile);
 	if (!StopNeighbors.Contains(TargetTile)) return;
 
@@ -628,7 +594,7 @@ void AML_PlayerController::OnMoveAndPlantStarted()
 	PendingPlantTargetTile = TargetTile;
 	bPendingPlantOnArrival = true;
 
-	StartMoveAlongPath(FullPath, GridMap);
+	StartMoveAlongPath(FullPath, BoardView);
 	bIsMoving = true;
 }
 
@@ -659,12 +625,19 @@ void AML_PlayerController::TickHoverPreview(float DeltaTime)
 	// Get tile under cursor
 	AML_Tile* HoveredTile = GetTileUnderCursor();
 
-	// Same tile as before → no update needed
-	if (HoveredTile == LastHoveredTile)
+	// Same tile as before on an unchanged board → no update needed
+	const AML_BoardSpawner* HoveredBoard = IsValid(HoveredTile) ? HoveredTile->GetBoardSpawnerFromTile() : nullptr;
+	const uint32 HoveredBoardSerial = HoveredBoard ? HoveredBoard->GetBoardState().GetChangeSerial() : 0;
+	if (HoveredTile == LastHoveredTile && HoveredBoardSerial == LastHoveredBoardSerial)
+	{
+		if (bPlantPreviewPending)
+			UpdatePlantPreview(HoveredTile);
 		return;
+	}
 
 	// Update last hovered
 	LastHoveredTile = HoveredTile;
+	LastHoveredBoardSerial = HoveredBoardSerial;
 
 	// No valid tile under cursor → clear preview
 	if (!IsValid(HoveredTile))
@@ -699,6 +672,8 @@ void AML_PlayerController::TickHoverPreview(float DeltaTime)
 		OnHoverPathUpdated(CurrentPreviewPath);
 	else
 		OnHoverPathCleared();
+
+	UpdatePlantPreview(HoveredTile);
 }
 
 void AML_PlayerController::ClearHoverPreview()
@@ -708,8 +683,45 @@ void AML_PlayerController::ClearHoverPreview()
 		CurrentPreviewPath.Empty();
 		OnHoverPathCleared();
 	}
+
+	if (LastHoveredTile)
+		UpdatePlantPreview(nullptr);
     
 	LastHoveredTile = nullptr;
+	LastHoveredBoardSerial = 0;
+	bPlantPreviewPending = false;
+}
+
+void AML_PlayerController::UpdatePlantPreview(AML_Tile* HoveredTile)
+{
+	UML_WavePropagationSubsystem* WavePropagationSubsystem = GetWorld()->GetSubsystem<UML_WavePropagationSubsystem>();
+	if (!WavePropagationSubsystem) return;
+
+	// Same rule as TryPlantGrass: a Dirt neighbor of the player, with energy left
+	bool bCanPlant = false;
+	if (IsValid(HoveredTile) && HoveredTile->GetCurrentType() == EML_TileType::Dirt && CurrentEnergy > 0 &&
+		IsValid(MycelandCharacter) && IsValid(MycelandCharacter->CurrentTileOn))
+	{
+		const FML_BoardView BoardView = MycelandCharacter->CurrentTileOn->GetBoardSpawnerFromTile()->GetBoardView();
+		for (const AML_Tile* Neighbor : BoardView.Neighbors(MycelandCharacter->CurrentTileOn->GetBoardIndex()))
+		{
+			if (Neighbor == HoveredTile)
+			{
+				bCanPlant = true;
+				break;
+			}
+		}
+	}
+
+	if (bCanPlant)
+	{
+		bPlantPreviewPending = !WavePropagationSubsystem->RequestPlantPreview(HoveredTile);
+	}
+	else
+	{
+		bPlantPreviewPending = false;
+		WavePropagationSubsystem->CancelPlantPreview();
+	}
 }
 
 TArray<AML_Tile*> AML_PlayerController::BuildPreviewPath(const AML_Tile* TargetTile) const
@@ -723,30 +735,30 @@ TArray<AML_Tile*> AML_PlayerController::BuildPreviewPath(const AML_Tile* TargetT
 	if (!IsValid(Board))
 		return Result;
 
-	const TMap<FIntPoint, AML_Tile*> GridMap = Board->GetGridMap();
+	const FML_BoardView BoardView = Board->GetBoardView();
 	const FIntPoint StartAxial = MycelandCharacter->CurrentTileOn->GetAxialCoord();
 	const FIntPoint GoalAxial = TargetTile->GetAxialCoord();
 
-	if (!GridMap.Contains(StartAxial) || !GridMap.Contains(GoalAxial))
+	if (!BoardView.Contains(StartAxial) || !BoardView.Contains(GoalAxial))
 		return Result;
 
-	if (!IsTileWalkable(GridMap[StartAxial]) || !IsTileWalkable(GridMap[GoalAxial]))
+	if (!IsTileWalkable(BoardView.Find(StartAxial)) || !IsTileWalkable(BoardView.Find(GoalAxial)))
 		return Result;
 
 	// Build axial path using BFS
 	TArray<FIntPoint> AxialPath;
-	if (!BuildPath_AxialBFS(StartAxial, GoalAxial, GridMap, AxialPath))
+	if (!BuildPath_AxialBFS(StartAxial, GoalAxial, BoardView, AxialPath))
 		return Result;
 
 	// Convert axial path to tile array
 	Result.Reserve(AxialPath.Num());
 	for (const FIntPoint& Axial : AxialPath)
 	{
-		if (AML_Tile* const* TilePtr = GridMap.Find(Axial))
+		if (AML_Tile* Tile = BoardView.Find(Axial))
 		{
-			if (IsValid(*TilePtr))
+			if (IsValid(Tile))
 			{
-				Result.Add(*TilePtr);
+				Result.Add(Tile);
 			}
 		}
 	}
@@ -778,24 +790,19 @@ void AML_PlayerController::TryPlantGrass(FHitResult HitResult, bool& CanPlantGra
 	AML_Tile* CurrentTileOn = MycelandCharacter->CurrentTileOn;
 	if (!CurrentTileOn) return;
 
-	const AActor* HitActor = HitResult.GetActor();
-	if (!HitActor) return;
+	AML_Tile* HitTileActor = AML_Tile::FromHitResult(HitResult);
+	if (!HitTileActor) return;
 
-	TArray<AML_Tile*> Neighbors = CurrentTileOn->GetBoardSpawnerFromTile()->GetNeighbors(CurrentTileOn);
-	for (const AML_Tile* Neighbor : Neighbors)
+	const FML_BoardView BoardView = CurrentTileOn->GetBoardSpawnerFromTile()->GetBoardView();
+	for (const AML_Tile* Neighbor : BoardView.Neighbors(CurrentTileOn->GetBoardIndex()))
 	{
-		if (!Neighbor) continue;
-
-		if (const AML_Tile* HitTileActor = Cast<AML_Tile>(HitActor))
+		if (HitTileActor == Neighbor &&
+			Neighbor->GetCurrentType() == EML_TileType::Dirt &&
+			CurrentEnergy > 0)
 		{
-			if (HitTileActor == Neighbor &&
-				Neighbor->GetCurrentType() == EML_TileType::Dirt &&
-				CurrentEnergy > 0)
-			{
-				HitTile = const_cast<AML_Tile*>(HitTileActor);
-				CanPlantGrass = true;
-				return;
-			}
+			HitTile = HitTileActor;
+			CanPlantGrass = true;
+			return;
 		}
 	}
 }
@@ -815,10 +822,10 @@ bool AML_PlayerController::MovePlayerToAxial(const FIntPoint& TargetAxial, bool
 	AML_BoardSpawner* Board = MycelandCharacter->CurrentTileOn->GetBoardSpawnerFromTile();
 	if (!IsValid(Board)) return false;
 
-	const TMap<FIntPoint, AML_Tile*> GridMap = Board->GetGridMap();
+	const FML_BoardView BoardView = Board->GetBoardView();
 	const FIntPoint StartAxial = MycelandCharacter->CurrentTileOn->GetAxialCoord();
 
-	if (!GridMap.Contains(StartAxial) || !GridMap.Contains(TargetAxial))
+	if (!BoardView.Contains(StartAxial) || !BoardView.Contains(TargetAxial))
 	{
 		if (bFallbackTeleport)
 			MycelandCharacter->SetActorLocation(TeleportFallbackWorld);
@@ -827,11 +834,11 @@ bool AML_PlayerController::MovePlayerToAxial(const FIntPoint& TargetAxial, bool
 
 	if (!bUsePath)
 	{
-		if (AML_Tile* const* TilePtr = GridMap.Find(TargetAxial))
+		if (const AML_Tile* Tile = BoardView.Find(TargetAxial))
 		{
-			if (IsValid(*TilePtr))
+			if (IsValid(Tile))
 			{
-				MycelandCharacter->SetActorLocation((*TilePtr)->GetActorLocation());
+				MycelandCharacter->SetActorLocation(Tile->GetActorLocation());
 				return true;
 			}
 		}
@@ -839,7 +846,7 @@ bool AML_PlayerController::MovePlayerToAxial(const FIntPoint& TargetAxial, bool
 	}
 
 	TArray<FIntPoint> AxialPath;
-	if (!BuildPath_AxialBFS(StartAxial, TargetAxial, GridMap, AxialPath))
+	if (!BuildPath_AxialBFS(StartAxial, TargetAxial, BoardView, AxialPath))
 	{
 		if (bFallbackTeleport)
 			MycelandCharacter->SetActorLocation(TeleportFallbackWorld);
@@ -853,15 +860,15 @@ bool AML_PlayerController::MovePlayerToAxial(const FIntPoint& TargetAxial, bool
 	if (APawn* P = GetPawn())
 		MoveStartWorld = P->GetActorLocation();
 
-	if (AML_Tile* const* TilePtr = GridMap.Find(TargetAxial))
-		MoveEndWorld = IsValid(*TilePtr) ? (*TilePtr)->GetActorLocation() : TeleportFallbackWorld;
+	if (const AML_Tile* Tile = BoardView.Find(TargetAxial))
+		MoveEndWorld = IsValid(Tile) ? Tile->GetActorLocation() : TeleportFallbackWorld;
 	else
 		MoveEndWorld = TeleportFallbackWorld;
 
 	ActiveMoveAxialPath = AxialPath;
 	ActiveMovePickedCollectibles.Reset();
 
-	StartMoveAlongPath(AxialPath, GridMap);
+	StartMoveAlongPath(AxialPath, BoardView);
 	return true;
 }
 
@@ -872,7 +879,7 @@ void AML_PlayerController::StartMoveAlongAxialPathForUndo(const TArray<FIntPoint
 	AML_BoardSpawner* Board = MycelandCharacter->CurrentTileOn->GetBoardSpawnerFromTile();
 	if (!IsValid(Board)) return;
 
-	const TMap<FIntPoint, AML_Tile*> GridMap = Board->GetGridMap();
+	const FML_BoardView BoardView = Board->GetBoardView();
 
 	bUndoMovePlayback = true;
 	bSuppressMoveRecording = true;
@@ -890,7 +897,7 @@ void AML_PlayerController::StartMoveAlongAxialPathForUndo(const TArray<FIntPoint
 	ActiveMoveAxialPath = AxialPath;
 	ActiveMovePickedCollectibles.Reset();
 
-	StartMoveAlongPath(AxialPath, GridMap);
+	StartMoveAlongPath(AxialPath, BoardView);
 }
 
 void AML_PlayerController::NotifyCollectiblePickedOnAxial(const FIntPoint& Axial)
@@ -0,0 +1,91 @@
+﻿// Copyright Myceland Team, All Rights Reserved.
+
+#include "Subsystem/ML_BoardRegistrySubsystem.h"
+
+#include "Tiles/ML_BoardSpawner.h"
+#include "Tiles/ML_Tile.h"
+
+void UML_BoardRegistrySubsystem::Deinitialize()
+{
+	Boards.Empty();
+	BoardTiles.Empty();
+	TileBoards.Empty();
+	Super::Deinitialize();
+}
+
+void UML_BoardRegistrySubsystem::RegisterBoard(AML_BoardSpawner* Board)
+{
+	if (!Board) return;
+
+	Boards.Add(Board);
+}
+
+void UML_BoardRegistrySubsystem::UnregisterBoard(AML_BoardSpawner* Board)
+{
+	if (!Board) return;
+
+	Boards.Remove(Board);
+}
+
+void UML_BoardRegistrySubsystem::RegisterTile(AML_Tile* Tile, AML_BoardSpawner* Board)
+{
+	if (!Tile || !Board) return;
+
+	TWeakObjectPtr<AML_BoardSpawner>& CurrentBoard = TileBoards.FindOrAdd(Tile);
+	if (CurrentBoard == Board) return;
+
+	if (TSet<TWeakObjectPtr<AML_Tile>>* PreviousTiles = BoardTiles.Find(CurrentBoard))
+	{
+		PreviousTiles->Remove(Tile);
+	}
+
+	CurrentBoard = Board;
+	BoardTiles.FindOrAdd(Board).Add(Tile);
+}
+
+void UML_BoardRegistrySubsystem::UnregisterTile(const AML_Tile* Tile)
+{
+	if (!Tile) return;
+
+	TWeakObjectPtr<AML_BoardSpawner> Board;
+	if (!TileBoards.RemoveAndCopyValue(Tile, Board)) return;
+
+	if (TSet<TWeakObjectPtr<AML_Tile>>* Tiles = BoardTiles.Find(Board))
+	{
+		Tiles->Remove(const_cast<AML_Tile*>(Tile));
+		if (Tiles->IsEmpty()) BoardTiles.Remove(Board);
+	}
+}
+
+AML_BoardSpawner* UML_BoardRegistrySubsystem::FindBoardForTile(const AML_Tile* Tile) const
+{
+	const TWeakObjectPtr<AML_BoardSpawner>* Board = TileBoards.Find(Tile);
+	return Board ? Board->Get() : nullptr;
+}
+
+void UML_BoardRegistrySubsystem::GetTilesOfBoard(const AML_BoardSpawner* Board, TArray<AML_Tile*>& OutTiles) const
+{
+	OutTiles.Reset();
+
+	const TSet<TWeakObjectPtr<AML_Tile>>* Tiles = BoardTiles.Find(const_cast<AML_BoardSpawner*>(Board));
+	if (!Tiles) return;
+
+	OutTiles.Reserve(Tiles->Num());
+	for (const TWeakObjectPtr<AML_Tile>& Tile : *Tiles)
+	{
+		if (Tile.IsValid()) OutTiles.Add(Tile.Get());
+	}
+}
+
+TArray<AML_BoardSpawner*> UML_BoardRegistrySubsystem::GetBoards() const
+{
+	TArray<AML_BoardSpawner*> Result;
+	Result.Reserve(Boards.Num());
+
+	for (const TWeakObjectPtr<AML_BoardSpawner>& Board : Boards)
+	{
+		if (Board.IsValid()) Result.Add(Board.Get());
+	}
+
+	return Result;
+}
@@ -0,0 +1,86 @@
+﻿// Copyright Myceland Team, All Rights Reserved.
+
+#include "Subsystem/ML_CollectiblePoolSubsystem.h"
+
+#include "Collectible/ML_Collectible.h"
+
+void UML_CollectiblePoolSubsystem::Deinitialize()
+{
+	Pools.Empty();
+	Super::Deinitialize();
+}
+
+AML_Collectible* UML_CollectiblePoolSubsystem::Acquire(const TSubclassOf<AML_Collectible> CollectibleClass, const FVector& Location, AML_Tile* OwningTile)
+{
+	UWorld* World = GetWorld();
+	if (!World || !CollectibleClass) return nullptr;
+
+	AML_Collectible* Collectible = nullptr;
+	if (FML_CollectiblePool* Pool = Pools.Find(CollectibleClass))
+	{
+		while (!Collectible && Pool->Free.Num() > 0)
+		{
+			Collectible = Pool->Free.Pop(EAllowShrinking::No);
+			if (!IsValid(Collectible)) Collectible = nullptr;
+		}
+	}
+
+	if (Collectible)
+	{
+		PoolHits++;
+
+		// Configure BEFORE activation, like a deferred spawn
+		Collectible->SetOwningTile(OwningTile);
+		Collectible->ActivateFromPool(Location);
+		return Collectible;
+	}
+
+	PoolMisses++;
+
+	const FTransform SpawnTransform(FRotator::ZeroRotator, Location);
+	Collectible = World->SpawnActorDeferred<AML_Collectible>(CollectibleClass, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	if (!Collectible) return nullptr;
+
+	// Configure BEFORE the spawn
+	Collectible->SetOwningTile(OwningTile);
+	Collectible->FinishSpawning(SpawnTransform);
+	Collectible->ActivateFromPool(Location);
+	return Collectible;
+}
+
+void UML_CollectiblePoolSubsystem::Release(AML_Collectible* Collectible)
+{
+	if (!IsValid(Collectible) || Collectible->IsInPool()) return;
+
+	Collectible->DeactivateToPool();
+	Pools.FindOrAdd(Collectible->GetClass()).Free.Add(Collectible);
+}
+
+void UML_CollectiblePoolSubsystem::Prewarm(const TSubclassOf<AML_Collectible> CollectibleClass, const int32 Count)
+{
+	UWorld* World = GetWorld();
+	if (!World || !CollectibleClass) return;
+
+	FML_CollectiblePool& Pool = Pools.FindOrAdd(CollectibleClass);
+	while (Pool.Free.Num() < Count)
+	{
+		FActorSpawnParameters Params;
+		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		AML_Collectible* Collectible = World->SpawnActor<AML_Collectible>(CollectibleClass, FTransform::Identity, Params);
+		if (!Collectible) break;
+
+		Collectible->DeactivateToPool();
+		Pool.Free.Add(Collectible);
+	}
+}
+
+int32 UML_CollectiblePoolSubsystem::GetNumPooled() const
+{
+	int32 NumPooled = 0;
+	for (const TPair<TSubclassOf<AML_Collectible>, FML_CollectiblePool>& Pair : Pools)
+	{
+		NumPooled += Pair.Value.Free.Num();
+	}
+	return NumPooled;
+}
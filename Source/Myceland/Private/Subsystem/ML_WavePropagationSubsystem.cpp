@@ -10,27 +10,147 @@
 #include "Tiles/ML_BoardSpawner.h"
 #include "Data Asset/ML_BiomeTileSet.h"
 #include "Waves/ML_PropagationWaves.h"
-#include "Waves/ChildWaves/ML_WaveCollectible.h"
+#include "Waves/ML_WavePipeline.h"
 #include "Collectible/ML_Collectible.h"
+#include "Subsystem/ML_CollectiblePoolSubsystem.h"
+
+namespace
+{
+	bool IsWinningState(const FML_BoardState& State)
+	{
+		return UML_WinLoseSubsystem::AreAllGoalsConnectedOnState(State, EML_TileType::Tree, {EML_TileType::Grass, EML_TileType::Water});
+	}
+}
+
+void UML_WavePropagationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	CompileWavePipeline();
+
+#if WITH_EDITOR
+	ObjectsReinstancedHandle = FCoreUObjectDelegates::OnObjectsReinstanced.AddUObject(this, &UML_WavePropagationSubsystem::OnObjectsReinstanced);
+#endif
+}
+
+void UML_WavePropagationSubsystem::Deinitialize()
+{
+#if WITH_EDITOR
+	FCoreUObjectDelegates::OnObjectsReinstanced.Remove(ObjectsReinstancedHandle);
+#endif
+
+	CancelPlantPreview();
+
+	// Workers only hold copies, their results are dropped
+	for (const TUniquePtr<FML_AmbientBoardTurn>& Turn : AmbientTurns)
+	{
+		if (Turn->CancelFlag.IsValid())
+			Turn->CancelFlag->store(true, std::memory_order_relaxed);
+	}
+	AmbientTurns.Empty();
+	Super::Deinitialize();
+}
+
+void UML_WavePropagationSubsystem::CompileWavePipeline()
+{
+	const UML_MycelandDeveloperSettings* Settings = UML_MycelandDeveloperSettings::GetMycelandDeveloperSettings();
+	WavePipeline = FML_WavePipeline::Compile(Settings->WavesPriority);
+
+	// Cached timelines were resolved by the previous waves
+	TurnCache.Empty(FMath::Max(0, Settings->TurnCacheSize));
+}
+
+#if WITH_EDITOR
+void UML_WavePropagationSubsystem::OnObjectsReinstanced(const TMap<UObject*, UObject*>& ReplacementMap)
+{
+	bool bStale = !WavePipeline.IsValid();
+	for (const TPair<UObject*, UObject*>& Replacement : ReplacementMap)
+	{
+		if (bStale) break;
+		bStale = WavePipeline.UsesWave(Replacement.Key);
+	}
+
+	if (bStale)
+		CompileWavePipeline();
+}
+#endif
 
 void UML_WavePropagationSubsystem::EnsureInitialized()
 {
 	if (!GetWorld()) return;
 
 	WinLoseSubsystem = GetWorld()->GetSubsystem<UML_WinLoseSubsystem>();
+	CollectiblePool = GetWorld()->GetSubsystem<UML_CollectiblePoolSubsystem>();
 	PlayerController = Cast<AML_PlayerController>(GetWorld()->GetFirstPlayerController());
 	DevSettings = UML_MycelandDeveloperSettings::GetMycelandDeveloperSettings();
 
-	ensure(PlayerController && WinLoseSubsystem);
+	ensure(PlayerController && WinLoseSubsystem && CollectiblePool);
 }
 
-void UML_WavePropagationSubsystem::CancelAllWaveTimers()
+// -------------------- Playback --------------------
+
+void UML_WavePropagationSubsystem::Tick(float DeltaTime)
 {
-	if (!GetWorld()) return;
+	PumpPlayback(DeltaTime);
+	PumpAmbientTurns(DeltaTime);
+	PollPlantPreview();
+}
+
+TStatId UML_WavePropagationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UML_WavePropagationSubsystem, STATGROUP_Tickables);
+}
+
+void UML_WavePropagationSubsystem::StartPlayback(TArray<float>&& Delays)
+{
+	Playback.TimeScale = DevSettings->WavePlaybackSpeed * PlaybackTimeScale;
+	Playback.FastForwardScale = DevSettings->WaveFastForwardSpeed;
+	Playback.Begin(MoveTemp(Delays));
 
-	FTimerManager& TM = GetWorld()->GetTimerManager();
-	TM.ClearTimer(IntraWaveTimerHandle);
-	TM.ClearTimer(InterWaveTimerHandle);
+	// Entries without delay are played right away, not on the next tick
+	PumpPlayback(0.f);
+}
+
+void UML_WavePropagationSubsystem::PumpPlayback(const float DeltaTime)
+{
+	int32 FirstEntry = 0;
+	const int32 NumEntries = Playback.Advance(DeltaTime, FirstEntry);
+	if (NumEntries == 0) return;
+
+	// Everything due this frame is played as one batch
+	TGuardValue<bool> PumpGuard(bIsPumpingPlayback, true);
+	if (bIsResolvingTiles)
+		PlayTimelineSteps(FirstEntry, NumEntries);
+	else if (bIsUndoAnimating)
+		PlayUndoGroups(FirstEntry, NumEntries);
+}
+
+void UML_WavePropagationSubsystem::StopPlayback()
+{
+	Playback.Stop();
+}
+
+void UML_WavePropagationSubsystem::SetWavePlaybackTimeScale(const float InTimeScale)
+{
+	if (!DevSettings) EnsureInitialized();
+
+	PlaybackTimeScale = FMath::Max(FML_WavePlaybackScheduler::MinTimeScale, InTimeScale);
+	if (!DevSettings) return;
+
+	Playback.TimeScale = DevSettings->WavePlaybackSpeed * PlaybackTimeScale;
+	for (const TUniquePtr<FML_AmbientBoardTurn>& Turn : AmbientTurns)
+		Turn->Playback.TimeScale = Playback.TimeScale;
+}
+
+void UML_WavePropagationSubsystem::SkipWaveAnimation()
+{
+	if (!Playback.IsPlaying()) return;
+
+	Playback.FlushAll();
+
+	// Called from a playback event (e.g. OnWaveStepApplied): the flush lands on the next tick
+	if (!bIsPumpingPlayback)
+		PumpPlayback(0.f);
 }
 
 void UML_WavePropagationSubsystem::BeginTurnRecord_Internal(AML_Tile* OriginTile)
@@ -76,7 +196,7 @@ void UML_WavePropagationSubsystem::RecordTileBeforeChange(AML_Tile* Tile, int32
 	FML_TileUndoDelta Delta;
 	Delta.Tile = Tile;
 	Delta.OldType = Tile->GetCurrentType();
-	Delta.bOldConsumedGrass = Tile->bConsumedGrass;
+	Delta.bOldConsumedGrass = Tile->HasConsumedGrass();
 	Delta.bOldHasCollectible = Tile->HasCollectible();
 
 	Delta.PriorityIndex = CurrentPriorityIndexForRecording;
@@ -92,6 +212,8 @@ void UML_WavePropagationSubsystem::RecordSpawnedActor(AActor* Spawned, int32 Dis
 
 	FML_SpawnUndoDelta D;
 	D.SpawnedActor = Spawned;
+	if (const AML_Collectible* Collectible = Cast<AML_Collectible>(Spawned))
+		D.PoolGeneration = Collectible->GetPoolGeneration();
 	D.PriorityIndex = CurrentPriorityIndexForRecording;
 	D.DistanceFromOrigin = DistanceFromOrigin;
 	D.Sequence = UndoSequenceCounter++;
@@ -106,6 +228,7 @@ void UML_WavePropagationSubsystem::EndTileResolved()
 	WinLoseSubsystem->TriggerFindConnectedGoalCheck();
 	
 	bIsResolvingTiles = false;
+	ActiveTimeline = FML_WaveTimeline();
 
 	CommitTurnRecord_Internal();
 
@@ -119,188 +242,536 @@ void UML_WavePropagationSubsystem::BeginTileResolved(AML_Tile* HitTile)
 	if (!PlayerController) EnsureInitialized();
 	if (!PlayerController || !DevSettings) return;
 
+	// Board still spawning (AML_BoardSpawner::bAsyncSpawn)
+	const AML_BoardSpawner* Board = HitTile->GetBoardSpawnerFromTile();
+	if (!Board || !Board->IsBoardReady()) return;
+
+	// The turn is resolved on the board as it is once the ambient turn is over
+	if (!FinishAmbientTurn(Board)) return;
+
 	bIsResolvingTiles = true;
 	PlayerController->DisableInput(PlayerController);
 
-	CurrentOriginTile = HitTile;
-	CurrentWaveIndex = 0;
-	bCycleHasChanges = false;
+	CancelPlantPreview();
 
-	ParasitesThatAteGrass.Empty();
-	PendingChanges.Empty();
+	CurrentOriginTile = HitTile;
+	CurrentBoard = HitTile->GetBoardSpawnerFromTile();
 
 	BeginTurnRecord_Internal(HitTile);
 
-	ProcessNextWave();
+	ResolveTurn();
+
+	StartPlayback(MakeTimelineDelays(ActiveTimeline));
+}
+
+TArray<float> UML_WavePropagationSubsystem::MakeTimelineDelays(const FML_WaveTimeline& Timeline) const
+{
+	// One entry per step, the first one right away, then the end of the turn
+	TArray<float> Delays;
+	Delays.Reserve(Timeline.Steps.Num() + 1);
+	for (const FML_WaveTimelineStep& Step : Timeline.Steps)
+	{
+		if (Delays.IsEmpty())
+			Delays.Add(0.f);
+		else
+			Delays.Add(Step.bStartsWave ? DevSettings->InterWaveDelay : DevSettings->IntraWaveDelay);
+	}
+
+	// The cycle ends on the check of the next priority
+	Delays.Add(Timeline.Steps.IsEmpty() ? 0.f : DevSettings->InterWaveDelay);
+
+	return Delays;
 }
 
 // -------------------- Forward waves --------------------
 
-void UML_WavePropagationSubsystem::RunWave()
+FML_WaveResolveParams UML_WavePropagationSubsystem::MakeResolveParams(const AML_BoardSpawner* Board, const int32 OriginIndex, const int32 PlayerIndex) const
 {
-	if (PendingChanges.Num() == 0)
+	FML_WaveResolveParams Params;
+	Params.OriginIndex = OriginIndex;
+	Params.PlayerIndex = PlayerIndex;
+	Params.Pipeline = &WavePipeline;
+
+	for (const FML_WaveStage& Stage : WavePipeline.GetStages())
 	{
-		EndTileResolved();
-		return;
+		const UML_PropagationWaves* Wave = Stage.Wave.Get();
+		const uint32* WaveSerial = Wave ? WaveChangeSerials.Find(MakeTuple(TObjectKey<AML_BoardSpawner>(Board), TObjectKey<UClass>(Wave->GetClass()))) : nullptr;
+		Params.WaveSerials.Add(WaveSerial ? *WaveSerial : 0);
 	}
 
-	const int32 CurrentDistance = PendingChanges[0].DistanceFromOrigin;
+	return Params;
+}
+
+void UML_WavePropagationSubsystem::ResolveTurn()
+{
+	const FML_BoardState& State = CurrentBoard->GetBoardState();
 
-	// Build the current "distance group" (wave step)
-	TArray<FML_WaveChange> CurrentWave;
-	int32 Index = 0;
-	while (Index < PendingChanges.Num() && PendingChanges[Index].DistanceFromOrigin == CurrentDistance)
+	FML_WaveResolveParams Params = MakeResolveParams(CurrentBoard, CurrentBoard->GetTileIndex(CurrentOriginTile),
+	                                                 CurrentBoard->GetTileIndex(WinLoseSubsystem->GetPlayerCurrentTile()));
+
+	const uint32 ResolveSerial = State.GetChangeSerial();
+
+	// Same board, same tiles, same origin and player: same turn (replays, plant-undo-plant)
+	const FML_TurnCacheKey CacheKey(CurrentBoard, State, Params.OriginIndex, Params.PlayerIndex, WavePipeline.GetRulesVersion());
+	const FML_WaveTimeline* CachedTimeline = TurnCache.Max() > 0 ? TurnCache.FindAndTouch(CacheKey) : nullptr;
+
+	if (CachedTimeline)
 	{
-		CurrentWave.Add(PendingChanges[Index]);
-		Index++;
+		++TurnCacheHits;
+		ActiveTimeline = *CachedTimeline;
 	}
-	PendingChanges.RemoveAt(0, CurrentWave.Num());
+	else
+	{
+		++TurnCacheMisses;
+		FML_WaveResolver::Resolve(State, Params, ActiveTimeline);
+
+		if (TurnCache.Max() > 0)
+			TurnCache.Add(CacheKey, ActiveTimeline);
+	}
+
+	ensureMsgf(!ActiveTimeline.bReachedCycleLimit, TEXT("Wave cycle still changing the board after %d cycles, turn cut"), Params.MaxCycles);
+
+	RecordResolvedTurn(CurrentBoard, CurrentOriginTile, ResolveSerial, ActiveTimeline);
 
-	for (const FML_WaveChange& Change : CurrentWave)
+	OnTurnResolved.Broadcast(IsWinningState(ActiveTimeline.FinalState), ActiveTimeline.bPlayerKilled);
+}
+
+void UML_WavePropagationSubsystem::RecordResolvedTurn(const AML_BoardSpawner* Board, const AML_Tile* OriginTile, const uint32 ResolveSerial, const FML_WaveTimeline& Timeline)
+{
+	if (Timeline.bDetectedLoop)
 	{
-		// Tile update
-		if (Change.Tile)
+		UE_LOG(LogTemp, Warning, TEXT("Waves loop on board %s: cycle %d ended on the board of cycle %d, turn cut (origin tile %s)"),
+		       *GetNameSafe(Board), Timeline.LoopEndCycle, Timeline.LoopStartCycle, *GetNameSafe(OriginTile));
+	}
+
+	// The played changes come after the resolve: waves that ran will see them (and a few more) as changed
+	const TConstArrayView<FML_WaveStage> Stages = WavePipeline.GetStages();
+	for (int32 StageIndex = 0; StageIndex < FMath::Min(Stages.Num(), Timeline.RanWaves.Num()); ++StageIndex)
+	{
+		const UML_PropagationWaves* Wave = Stages[StageIndex].Wave.Get();
+		if (!Timeline.RanWaves[StageIndex] || !Wave) continue;
+
+		WaveChangeSerials.Add(MakeTuple(TObjectKey<AML_BoardSpawner>(Board), TObjectKey<UClass>(Wave->GetClass())), ResolveSerial);
+	}
+}
+
+// -------------------- Plant preview --------------------
+
+bool UML_WavePropagationSubsystem::RequestPlantPreview(AML_Tile* Tile)
+{
+	CancelPlantPreview();
+
+	if (!IsValid(Tile) || bIsResolvingTiles || bIsUndoAnimating) return false;
+	if (!WinLoseSubsystem) EnsureInitialized();
+	if (!WinLoseSubsystem) return false;
+
+	const AML_BoardSpawner* Board = Tile->GetBoardSpawnerFromTile();
+	if (!Board || !Board->IsBoardReady()) return false;
+
+	const FML_BoardState& State = Board->GetBoardState();
+	const int32 OriginIndex = Board->GetTileIndex(Tile);
+	if (OriginIndex == INDEX_NONE) return false;
+
+	const int32 PlayerIndex = Board->GetTileIndex(WinLoseSubsystem->GetPlayerCurrentTile());
+	const FML_TurnCacheKey Key(Board, State, OriginIndex, PlayerIndex, WavePipeline.GetRulesVersion());
+
+	PreviewTile = Tile;
+
+	if (const FML_WaveTimeline* CachedTimeline = TurnCache.Max() > 0 ? TurnCache.FindAndTouch(Key) : nullptr)
+	{
+		DeliverPlantPreview(*CachedTimeline, IsWinningState(CachedTimeline->FinalState));
+		return true;
+	}
+
+	PreviewKey = Key;
+	PreviewCancelFlag = MakeShared<std::atomic<bool>, ESPMode::ThreadSafe>(false);
+
+	// The worker only sees copies: the board state, the params and a snapshot of the pipeline (CDOs and their rules)
+	PreviewTask = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[State, Params = MakeResolveParams(Board, OriginIndex, PlayerIndex), Pipeline = WavePipeline.Snapshot(), CancelFlag = PreviewCancelFlag]() mutable
 		{
-			const EML_TileType OldType = Change.Tile->GetCurrentType();
-			AML_Tile* Tile = Change.Tile;
-			if (!IsValid(Tile)) continue;
+			Params.Pipeline = &Pipeline;
+			Params.CancelFlag = CancelFlag.Get();
+
+			FML_PlantPreviewOutcome Outcome;
+			FML_WaveResolver::Resolve(State, Params, Outcome.Timeline);
+			if (!Outcome.Timeline.bCancelled)
+				Outcome.bWin = IsWinningState(Outcome.Timeline.FinalState);
+			return Outcome;
+		});
 
-			RecordTileBeforeChange(Tile, Change.DistanceFromOrigin);
+	return true;
+}
 
-			const UML_BiomeTileSet* TileSet = Tile->GetBoardSpawnerFromTile()->GetBiomeTileSet();
-			if (!TileSet) return;
+void UML_WavePropagationSubsystem::CancelPlantPreview()
+{
+	if (PreviewCancelFlag.IsValid())
+		PreviewCancelFlag->store(true, std::memory_order_relaxed);
 
-			if (!bUndoInProgress)
-				Tile->UpdateClassAtRuntime(Change.TargetType, TileSet->GetClassFromTileType(Change.TargetType));
-			else
-				Tile->UpdateClassAtRuntime_Silent(Change.TargetType, TileSet->GetClassFromTileType(Change.TargetType));
+	// The worker finishes on its own and its result is dropped
+	PreviewTask = UE::Tasks::TTask<FML_PlantPreviewOutcome>();
+	PreviewCancelFlag.Reset();
+	PreviewKey.Reset();
 
-			// Parasite bookkeeping
-			if (Tile->GetCurrentType() == EML_TileType::Parasite && Tile->bConsumedGrass)
-			{
-				ParasitesThatAteGrass.Add(Tile);
-				Tile->bConsumedGrass = false;
-			}
-			
-			if (Change.Tile == WinLoseSubsystem->GetPlayerCurrentTile())
-			{
-				WinLoseSubsystem->CheckPlayerKilled(Change.Tile);
-			}
-			
-			if (OldType != Change.TargetType) bCycleHasChanges = true;
+	// Lets listeners take down what the previous request showed, or was about to show
+	if (PreviewTile)
+	{
+		PreviewTile = nullptr;
+		OnPlantPreviewCleared.Broadcast();
+	}
+}
+
+void UML_WavePropagationSubsystem::PollPlantPreview()
+{
+	if (!PreviewTask.IsValid() || !PreviewTask.IsCompleted()) return;
+
+	const FML_PlantPreviewOutcome Outcome = MoveTemp(PreviewTask.GetResult());
+	const FML_TurnCacheKey Key = PreviewKey.GetValue();
+	PreviewTask = UE::Tasks::TTask<FML_PlantPreviewOutcome>();
+	PreviewCancelFlag.Reset();
+	PreviewKey.Reset();
+
+	if (Outcome.Timeline.bCancelled) return;
+
+	// Planting right after the preview plays this timeline without resolving again
+	if (TurnCache.Max() > 0)
+		TurnCache.Add(Key, Outcome.Timeline);
+
+	// The board moved on while the worker ran
+	const AML_BoardSpawner* Board = IsValid(PreviewTile) ? PreviewTile->GetBoardSpawnerFromTile() : nullptr;
+	if (!Board || Board->GetBoardState().GetHash() != Key.StateHash) return;
+
+	DeliverPlantPreview(Outcome.Timeline, Outcome.bWin);
+}
+
+void UML_WavePropagationSubsystem::DeliverPlantPreview(const FML_WaveTimeline& Timeline, const bool bWin)
+{
+	const AML_BoardSpawner* Board = IsValid(PreviewTile) ? PreviewTile->GetBoardSpawnerFromTile() : nullptr;
+	if (!Board) return;
+
+	const FML_BoardState& State = Board->GetBoardState();
+	const FML_BoardState& FinalState = Timeline.FinalState;
+
+	FML_PlantPreview Preview;
+	Preview.OriginTile = PreviewTile;
+	Preview.bWin = bWin;
+	Preview.bPlayerKilled = Timeline.bPlayerKilled;
+
+	for (int32 Index = 0; Index < FMath::Min(State.Num(), FinalState.Num()); ++Index)
+	{
+		AML_Tile* Tile = Board->GetTileByIndex(Index);
+		if (!Tile) continue;
+
+		if (FinalState.GetType(Index) != State.GetType(Index))
+		{
+			FML_TileTypeChange& TileChange = Preview.TileChanges.AddDefaulted_GetRef();
+			TileChange.Tile = Tile;
+			TileChange.OldType = State.GetType(Index);
+			TileChange.NewType = FinalState.GetType(Index);
 		}
-		// Collectible spawn
-		else if (Change.CollectibleClass)
+
+		if (FinalState.HasCollectible(Index) && !State.HasCollectible(Index))
 		{
-			// Collectible wave - Deferred Spawn
-			FActorSpawnParameters Params;
-			Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-			
-			// Create the actor WITHOUT the spawn (deferred)
-			AML_Collectible* Collectible = GetWorld()->SpawnActorDeferred<AML_Collectible>(Change.CollectibleClass, FTransform(FRotator::ZeroRotator, Change.SpawnLocation), nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
-			if (Collectible)
-			{
-				// Configure BEFORE the spawn
-				Collectible->SetOwningTile(Change.Neighbor);
-        
-				// Finish spawning
-				Collectible->FinishSpawning(FTransform(FRotator::ZeroRotator, Change.SpawnLocation));
+			Preview.CollectibleTiles.Add(Tile);
+		}
+	}
+
+	OnPlantPreviewReady.Broadcast(Preview);
+}
+
+void UML_WavePropagationSubsystem::PlayTimelineSteps(const int32 FirstStep, const int32 NumEntries)
+{
+	const int32 NumSteps = ActiveTimeline.Steps.Num();
+	const int32 EndEntry = FirstStep + NumEntries;
 
+	// Looked up once per batch rather than once per change
+	const AML_Tile* PlayerTile = WinLoseSubsystem->GetPlayerCurrentTile();
+
+	for (int32 StepIndex = FirstStep; StepIndex < FMath::Min(EndEntry, NumSteps); ++StepIndex)
+	{
+		ApplyTimelineStep(CurrentBoard, ActiveTimeline, ActiveTimeline.Steps[StepIndex], PlayerTile, true);
+	}
+
+	// One physics update for the whole batch
+	if (IsValid(CurrentBoard))
+		CurrentBoard->FlushTileCollision();
+
+	// Last entry is the end of the turn
+	if (EndEntry > NumSteps)
+	{
+		EndTileResolved();
+	}
+}
+
+void UML_WavePropagationSubsystem::ApplyTimelineStep(AML_BoardSpawner* Board, const FML_WaveTimeline& Timeline, const FML_WaveTimelineStep& Step,
+                                                     const AML_Tile* PlayerTile, const bool bRecordUndo)
+{
+	if (bRecordUndo)
+		CurrentPriorityIndexForRecording = Step.PriorityIndex;
+
+	const UML_BiomeTileSet* TileSet = IsValid(Board) ? Board->GetBiomeTileSet() : nullptr;
+	if (!TileSet) return;
+
+	StepTileChanges.Reset();
+
+	for (const FML_BoardChange& Change : Timeline.GetChanges(Step))
+	{
+		AML_Tile* Tile = Board->GetTileByIndex(Change.TileIndex);
+		if (!IsValid(Tile)) continue;
+
+		// Collectible spawn - reused from the pool (or spawned on a pool miss)
+		if (Change.bSpawnCollectible)
+		{
+			// Record undo snapshot before flipping the flag
+			if (bRecordUndo) RecordTileBeforeChange(Tile, Change.DistanceFromOrigin);
+			Tile->SetHasCollectible(true);
+
+			AML_Collectible* Collectible = CollectiblePool->Acquire(TileSet->GetCollectibleClass(), Tile->GetActorLocation(), Tile);
+			if (Collectible && bRecordUndo)
+			{
 				RecordSpawnedActor(Collectible, Change.DistanceFromOrigin);
-        
-				bCycleHasChanges = true;
 			}
+			continue;
+		}
+
+		// Tile update
+		if (bRecordUndo) RecordTileBeforeChange(Tile, Change.DistanceFromOrigin);
+		const EML_TileType OldType = Tile->GetCurrentType();
+
+		if (!bUndoInProgress)
+			Tile->UpdateClassAtRuntime(Change.TargetType, TileSet->GetClassFromTileType(Change.TargetType), !DevSettings->bBatchTileChangeEvents);
+		else
+			Tile->UpdateClassAtRuntime_Silent(Change.TargetType, TileSet->GetClassFromTileType(Change.TargetType));
+
+		if (Tile->GetCurrentType() != OldType)
+		{
+			FML_TileTypeChange& TileChange = StepTileChanges.AddDefaulted_GetRef();
+			TileChange.Tile = Tile;
+			TileChange.OldType = OldType;
+			TileChange.NewType = Tile->GetCurrentType();
+		}
+
+		// Parasite bookkeeping already done by the resolver, keep the tile in sync with it
+		if (Tile->GetCurrentType() == EML_TileType::Parasite && Tile->HasConsumedGrass())
+		{
+			Tile->SetConsumedGrass(false);
+		}
+
+		if (Tile == PlayerTile)
+		{
+			WinLoseSubsystem->CheckPlayerKilled(Tile);
 		}
 	}
 
-	// Schedule next distance step (intra-wave) or next priority (inter-wave)
-	if (PendingChanges.Num() > 0)
+	if (StepTileChanges.Num() > 0)
 	{
-		GetWorld()->GetTimerManager().SetTimer(IntraWaveTimerHandle, this, &UML_WavePropagationSubsystem::RunWave, DevSettings->IntraWaveDelay, false);
+		OnWaveStepApplied.Broadcast(Board, Step.PriorityIndex, Step.DistanceFromOrigin, StepTileChanges);
 	}
-	else
+}
+
+// -------------------- Ambient boards --------------------
+
+int32 UML_WavePropagationSubsystem::ResolveAmbientTurns(const TArray<AML_Tile*>& OriginTiles)
+{
+	if (!WinLoseSubsystem) EnsureInitialized();
+	if (!WinLoseSubsystem || !DevSettings) return 0;
+
+	// The board of the player belongs to its turns and its undo stack
+	const AML_Tile* PlayerTile = WinLoseSubsystem->GetPlayerCurrentTile();
+	const AML_BoardSpawner* PlayerBoard = PlayerTile ? PlayerTile->GetBoardSpawnerFromTile() : nullptr;
+
+	int32 NumStarted = 0;
+	for (AML_Tile* OriginTile : OriginTiles)
 	{
-		ScheduleNextPriority();
+		if (!IsValid(OriginTile)) continue;
+
+		AML_BoardSpawner* Board = OriginTile->GetBoardSpawnerFromTile();
+		if (!Board || !Board->IsBoardReady() || Board == PlayerBoard || HasAmbientTurn(Board) || IsBoardInUndoStack(Board)) continue;
+		if ((bIsResolvingTiles || bIsUndoAnimating) && Board == CurrentBoard) continue;
+
+		const int32 OriginIndex = Board->GetTileIndex(OriginTile);
+		if (OriginIndex == INDEX_NONE) continue;
+
+		const FML_BoardState& State = Board->GetBoardState();
+		FML_AmbientBoardTurn& Turn = *AmbientTurns.Add_GetRef(MakeUnique<FML_AmbientBoardTurn>(
+			Board, OriginTile, FML_TurnCacheKey(Board, State, OriginIndex, INDEX_NONE, WavePipeline.GetRulesVersion()), State.GetChangeSerial()));
+		Turn.Playback.TimeScale = DevSettings->WavePlaybackSpeed * PlaybackTimeScale;
+		Turn.Playback.FastForwardScale = DevSettings->WaveFastForwardSpeed;
+		++NumStarted;
+
+		if (const FML_WaveTimeline* CachedTimeline = TurnCache.Max() > 0 ? TurnCache.FindAndTouch(Turn.CacheKey) : nullptr)
+		{
+			++TurnCacheHits;
+			Turn.Timeline = *CachedTimeline;
+			RecordResolvedTurn(Board, OriginTile, Turn.ResolveSerial, Turn.Timeline);
+			Turn.Playback.Begin(MakeTimelineDelays(Turn.Timeline));
+			continue;
+		}
+
+		++TurnCacheMisses;
+
+		// One task per board, the boards resolve in parallel on copies (board state, params, pipeline snapshot)
+		Turn.CancelFlag = MakeShared<std::atomic<bool>, ESPMode::ThreadSafe>(false);
+		Turn.Task = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+			[State, Params = MakeResolveParams(Board, OriginIndex, INDEX_NONE), Pipeline = WavePipeline.Snapshot(), CancelFlag = Turn.CancelFlag]() mutable
+			{
+				Params.Pipeline = &Pipeline;
+				Params.CancelFlag = CancelFlag.Get();
+
+				FML_WaveTimeline Timeline;
+				FML_WaveResolver::Resolve(State, Params, Timeline);
+				return Timeline;
+			});
 	}
+
+	return NumStarted;
 }
 
-void UML_WavePropagationSubsystem::ScheduleNextPriority()
+bool UML_WavePropagationSubsystem::HasAmbientTurn(const AML_BoardSpawner* Board) const
 {
-	GetWorld()->GetTimerManager().SetTimer(
-		InterWaveTimerHandle,
-		this,
-		&UML_WavePropagationSubsystem::ProcessNextWave,
-		DevSettings->InterWaveDelay,
-		false
-	);
+	return Board && AmbientTurns.ContainsByPredicate([Board](const TUniquePtr<FML_AmbientBoardTurn>& Turn)
+	{
+		return !Turn->bFinished && Turn->Board.Get() == Board;
+	});
 }
 
-void UML_WavePropagationSubsystem::ProcessNextWave()
+void UML_WavePropagationSubsystem::PumpAmbientTurns(const float DeltaTime)
 {
-	if (!DevSettings || !CurrentOriginTile)
+	if (AmbientTurns.IsEmpty() || bIsPumpingAmbientTurns) return;
+
+	TGuardValue<bool> PumpGuard(bIsPumpingAmbientTurns, true);
+
+	// Looked up once per frame rather than once per change
+	const AML_Tile* PlayerTile = WinLoseSubsystem ? WinLoseSubsystem->GetPlayerCurrentTile() : nullptr;
+
+	// Turns started by the events of this pump wait for the next one
+	const int32 NumTurns = AmbientTurns.Num();
+	for (int32 TurnIndex = 0; TurnIndex < NumTurns; ++TurnIndex)
 	{
-		EndTileResolved();
-		return;
+		PlayAmbientTurn(*AmbientTurns[TurnIndex], DeltaTime, PlayerTile);
 	}
 
-	// End of all priorities
-	if (CurrentWaveIndex >= DevSettings->WavesPriority.Num())
+	TArray<AML_BoardSpawner*> FinishedBoards;
+	for (int32 TurnIndex = AmbientTurns.Num() - 1; TurnIndex >= 0; --TurnIndex)
 	{
-		// Restart cycle if changes occurred (propagation chain reaction)
-		if (bCycleHasChanges)
-		{
-			CurrentWaveIndex = 0;
-			bCycleHasChanges = false;
-			ProcessNextWave();
-			return;
-		}
+		const FML_AmbientBoardTurn& Turn = *AmbientTurns[TurnIndex];
+		if (!Turn.bFinished) continue;
 
-		EndTileResolved();
-		return;
+		AML_BoardSpawner* Board = Turn.Board.Get();
+		if (Board && !Turn.bDropped)
+			FinishedBoards.Add(Board);
+
+		AmbientTurns.RemoveAt(TurnIndex);
 	}
 
-	UML_PropagationWaves* WaveLogic = DevSettings->WavesPriority[CurrentWaveIndex]->GetDefaultObject<UML_PropagationWaves>();
-	if (!WaveLogic)
+	for (AML_BoardSpawner* Board : FinishedBoards)
 	{
-		CurrentWaveIndex++;
-		ProcessNextWave();
-		return;
+		OnAmbientTurnFinished.Broadcast(Board);
 	}
+}
 
-	CurrentPriorityIndexForRecording = CurrentWaveIndex;
-	CurrentWaveIndex++;
-
-	PendingChanges.Empty();
+void UML_WavePropagationSubsystem::PlayAmbientTurn(FML_AmbientBoardTurn& Turn, const float DeltaTime, const AML_Tile* PlayerTile)
+{
+	if (Turn.bFinished) return;
 
-	// Collectible wave uses a dedicated entry point
-	if (UML_WaveCollectible* CollectibleWave = Cast<UML_WaveCollectible>(WaveLogic))
+	AML_BoardSpawner* Board = Turn.Board.Get();
+	if (!Board)
 	{
-		CollectibleWave->ComputeWaveForCollectibles(CurrentOriginTile, ParasitesThatAteGrass, PendingChanges);
-		ParasitesThatAteGrass.Empty();
+		Turn.bDropped = Turn.bFinished = true;
+		return;
 	}
-	else
+
+	if (Turn.Task.IsValid())
 	{
-		WaveLogic->ComputeWave(CurrentOriginTile, PendingChanges);
+		if (!Turn.Task.IsCompleted()) return;
+
+		Turn.Timeline = MoveTemp(Turn.Task.GetResult());
+		Turn.Task = UE::Tasks::TTask<FML_WaveTimeline>();
+		Turn.CancelFlag.Reset();
+
+		if (Turn.Timeline.bCancelled)
+		{
+			Turn.bDropped = Turn.bFinished = true;
+			return;
+		}
+
+		if (TurnCache.Max() > 0)
+			TurnCache.Add(Turn.CacheKey, Turn.Timeline);
+
+		// The board changed while the worker ran (the player planted on it, a turn was undone)
+		if (Board->GetBoardState().GetChangeSerial() != Turn.ResolveSerial)
+		{
+			Turn.bDropped = Turn.bFinished = true;
+			return;
+		}
+
+		RecordResolvedTurn(Board, Turn.OriginTile.Get(), Turn.ResolveSerial, Turn.Timeline);
+		Turn.Playback.Begin(MakeTimelineDelays(Turn.Timeline));
 	}
 
-	if (PendingChanges.Num() == 0)
+	if (Turn.bSkipPlayback)
+		Turn.Playback.FlushAll();
+
+	int32 FirstEntry = 0;
+	const int32 NumEntries = Turn.Playback.Advance(DeltaTime, FirstEntry);
+	if (NumEntries == 0) return;
+
+	const int32 NumSteps = Turn.Timeline.Steps.Num();
+	const int32 EndEntry = FirstEntry + NumEntries;
+	for (int32 StepIndex = FirstEntry; StepIndex < FMath::Min(EndEntry, NumSteps); ++StepIndex)
 	{
-		// No changes in this wave → STOP immediately
-		EndTileResolved();
-		return;
+		ApplyTimelineStep(Board, Turn.Timeline, Turn.Timeline.Steps[StepIndex], PlayerTile, false);
 	}
 
-	PendingChanges.Sort([](const FML_WaveChange& A, const FML_WaveChange& B)
+	if (IsValid(Board))
+		Board->FlushTileCollision();
+
+	// Last entry is the end of the turn
+	if (EndEntry > NumSteps)
+		Turn.bFinished = true;
+}
+
+bool UML_WavePropagationSubsystem::IsBoardInUndoStack(const AML_BoardSpawner* Board) const
+{
+	return ActionUndoStack.ContainsByPredicate([Board](const FML_ActionUndoRecord& Action)
 	{
-		return A.DistanceFromOrigin < B.DistanceFromOrigin;
+		const AML_Tile* OriginTile = Action.Turn.OriginTile.Get();
+		return Action.Type == EML_UndoActionType::PlantWaves && OriginTile && OriginTile->GetBoardSpawnerFromTile() == Board;
 	});
+}
+
+bool UML_WavePropagationSubsystem::FinishAmbientTurn(const AML_BoardSpawner* Board)
+{
+	if (!HasAmbientTurn(Board)) return true;
+	if (bIsPumpingAmbientTurns) return false;
 
-	RunWave();
+	for (const TUniquePtr<FML_AmbientBoardTurn>& Turn : AmbientTurns)
+	{
+		if (Turn->bFinished || Turn->Board.Get() != Board) continue;
+
+		// Nothing applied yet: dropped rather than waited for on the game thread
+		if (Turn->Task.IsValid() && !Turn->Task.IsCompleted())
+		{
+			Turn->CancelFlag->store(true, std::memory_order_relaxed);
+			Turn->Task = UE::Tasks::TTask<FML_WaveTimeline>();
+			Turn->bDropped = Turn->bFinished = true;
+			continue;
+		}
+
+		Turn->bSkipPlayback = true;
+	}
+
+	PumpAmbientTurns(0.f);
+	return !HasAmbientTurn(Board);
 }
 
-void UML_WavePropagationSubsystem::RecordTileForUndo(AML_Tile* Tile, int32 DistanceFromOrigin)
+void UML_WavePropagationSubsystem::GetTurnCacheStats(int32& OutHits, int32& OutMisses, float& OutHitRate) const
 {
-	RecordTileBeforeChange(Tile, DistanceFromOrigin);
+	OutHits = TurnCacheHits;
+	OutMisses = TurnCacheMisses;
+
+	const int32 Lookups = TurnCacheHits + TurnCacheMisses;
+	OutHitRate = Lookups > 0 ? static_cast<float>(TurnCacheHits) / Lookups : 0.f;
 }
 
 // -------------------- Action recording (Move) --------------------
@@ -344,9 +815,12 @@ bool UML_WavePropagationSubsystem::UndoLastAction_Animated()
 	if (bIsResolvingTiles || bIsUndoAnimating) return false;
 	if (ActionUndoStack.Num() == 0) return false;
 
-	CancelAllWaveTimers();
+	StopPlayback();
 	PlayerController->DisableInput(PlayerController);
 
+	// Restored tiles do not keep the waves' invariants, the next waves scan the whole boards
+	WaveChangeSerials.Reset();
+
 	const FML_ActionUndoRecord Action = ActionUndoStack.Pop();
 
 	// MOVE: play reversed path
@@ -388,7 +862,7 @@ bool UML_WavePropagationSubsystem::UndoLastAction_Animated()
 			return A.Sequence > B.Sequence;
 		});
 
-		RunUndoWave();
+		StartUndoWaves();
 		return true;
 	}
 
@@ -396,65 +870,50 @@ bool UML_WavePropagationSubsystem::UndoLastAction_Animated()
 	return false;
 }
 
-void UML_WavePropagationSubsystem::RunUndoWave()
+void UML_WavePropagationSubsystem::StartUndoWaves()
 {
-	if (PendingUndoTileDeltas.Num() == 0 && PendingUndoSpawnDeltas.Num() == 0)
+	// Groups in reverse playback order: priority desc, then distance desc
+	UndoGroups.Reset();
+	for (const FML_TileUndoDelta& TD : PendingUndoTileDeltas)
+		UndoGroups.AddUnique(FIntPoint(TD.PriorityIndex, TD.DistanceFromOrigin));
+	for (const FML_SpawnUndoDelta& SD : PendingUndoSpawnDeltas)
+		UndoGroups.AddUnique(FIntPoint(SD.PriorityIndex, SD.DistanceFromOrigin));
+
+	UndoGroups.Sort([](const FIntPoint& A, const FIntPoint& B)
 	{
-		FinishUndoAnimation();
-		return;
-	}
+		if (A.X != B.X) return A.X > B.X;
+		return A.Y > B.Y;
+	});
 
-	auto PeekKey = [](int32& OutPri, int32& OutDist,
-		const bool bHasTile, const FML_TileUndoDelta& TD,
-		const bool bHasSpawn, const FML_SpawnUndoDelta& SD)
+	// One entry per group, the first one right away, then the end of the undo with no delay
+	TArray<float> Delays;
+	Delays.Reserve(UndoGroups.Num() + 1);
+	for (int32 GroupIndex = 0; GroupIndex < UndoGroups.Num(); ++GroupIndex)
 	{
-		if (bHasTile && !bHasSpawn) { OutPri = TD.PriorityIndex; OutDist = TD.DistanceFromOrigin; return; }
-		if (!bHasTile && bHasSpawn) { OutPri = SD.PriorityIndex; OutDist = SD.DistanceFromOrigin; return; }
-
-		// Both exist: pick the "largest" group key in our order
-		if (TD.PriorityIndex != SD.PriorityIndex)
-		{
-			if (TD.PriorityIndex > SD.PriorityIndex) { OutPri = TD.PriorityIndex; OutDist = TD.DistanceFromOrigin; }
-			else { OutPri = SD.PriorityIndex; OutDist = SD.DistanceFromOrigin; }
-			return;
-		}
-
-		// Same priority -> larger distance first
-		if (TD.DistanceFromOrigin >= SD.DistanceFromOrigin) { OutPri = TD.PriorityIndex; OutDist = TD.DistanceFromOrigin; }
-		else { OutPri = SD.PriorityIndex; OutDist = SD.DistanceFromOrigin; }
-	};
-
-	int32 GroupPri = 0, GroupDist = 0;
+		if (GroupIndex == 0)
+			Delays.Add(0.f);
+		else
+			Delays.Add(UndoGroups[GroupIndex].X != UndoGroups[GroupIndex - 1].X ? DevSettings->InterWaveDelay : DevSettings->IntraWaveDelay);
+	}
+	Delays.Add(0.f);
 
-	const bool bHasTile = PendingUndoTileDeltas.Num() > 0;
-	const bool bHasSpawn = PendingUndoSpawnDeltas.Num() > 0;
+	StartPlayback(MoveTemp(Delays));
+}
 
-	PeekKey(
-		GroupPri, GroupDist,
-		bHasTile, bHasTile ? PendingUndoTileDeltas[0] : FML_TileUndoDelta{},
-		bHasSpawn, bHasSpawn ? PendingUndoSpawnDeltas[0] : FML_SpawnUndoDelta{}
-	);
+void UML_WavePropagationSubsystem::PlayUndoGroups(const int32 FirstGroup, const int32 NumEntries)
+{
+	const int32 EndEntry = FirstGroup + NumEntries;
 
-	ApplyUndoWaveGroup(GroupPri, GroupDist);
+	for (int32 GroupIndex = FirstGroup; GroupIndex < FMath::Min(EndEntry, UndoGroups.Num()); ++GroupIndex)
+	{
+		ApplyUndoWaveGroup(UndoGroups[GroupIndex].X, UndoGroups[GroupIndex].Y);
+	}
 
-	if (PendingUndoTileDeltas.Num() == 0 && PendingUndoSpawnDeltas.Num() == 0)
+	// Last entry is the end of the undo
+	if (EndEntry > UndoGroups.Num())
 	{
 		FinishUndoAnimation();
-		return;
 	}
-
-	int32 NextPri = 0, NextDist = 0;
-	const bool bHasTile2 = PendingUndoTileDeltas.Num() > 0;
-	const bool bHasSpawn2 = PendingUndoSpawnDeltas.Num() > 0;
-
-	PeekKey(
-		NextPri, NextDist,
-		bHasTile2, bHasTile2 ? PendingUndoTileDeltas[0] : FML_TileUndoDelta{},
-		bHasSpawn2, bHasSpawn2 ? PendingUndoSpawnDeltas[0] : FML_SpawnUndoDelta{}
-	);
-
-	const float Delay = (NextPri != GroupPri) ? DevSettings->InterWaveDelay : DevSettings->IntraWaveDelay;
-	ScheduleNextUndoWave(Delay);
 }
 
 void UML_WavePropagationSubsystem::ApplyUndoWaveGroup(int32 PriorityIndex, int32 DistanceFromOrigin)
@@ -467,7 +926,14 @@ void UML_WavePropagationSubsystem::ApplyUndoWaveGroup(int32 PriorityIndex, int32
 		{
 			if (AActor* A = SD.SpawnedActor.Get())
 			{
-				if (IsValid(A)) A->Destroy();
+				if (AML_Collectible* Collectible = Cast<AML_Collectible>(A))
+				{
+					if (Collectible->GetPoolGeneration() == SD.PoolGeneration) CollectiblePool->Release(Collectible);
+				}
+				else if (IsValid(A))
+				{
+					A->Destroy();
+				}
 			}
 
 			PendingUndoSpawnDeltas.RemoveAt(i);
@@ -506,7 +972,7 @@ void UML_WavePropagationSubsystem::ApplyUndoWaveGroup(int32 PriorityIndex, int32
 						Tile->SetHasCollectible(bShouldHave);
 					}
 
-					Tile->bConsumedGrass = TD.bOldConsumedGrass;
+					Tile->SetConsumedGrass(TD.bOldConsumedGrass);
 				}
 			}
 
@@ -518,19 +984,6 @@ void UML_WavePropagationSubsystem::ApplyUndoWaveGroup(int32 PriorityIndex, int32
 	bUndoInProgress = false;
 }
 
-void UML_WavePropagationSubsystem::ScheduleNextUndoWave(float Delay)
-{
-	if (!GetWorld()) return;
-
-	GetWorld()->GetTimerManager().SetTimer(
-		IntraWaveTimerHandle,
-		this,
-		&UML_WavePropagationSubsystem::RunUndoWave,
-		Delay,
-		false
-	);
-}
-
 void UML_WavePropagationSubsystem::FinishUndoAnimation()
 {
 	bIsUndoAnimating = false;
@@ -538,6 +991,7 @@ void UML_WavePropagationSubsystem::FinishUndoAnimation()
 
 	PendingUndoTileDeltas.Reset();
 	PendingUndoSpawnDeltas.Reset();
+	UndoGroups.Reset();
 	ActiveUndoRecord = FML_TurnUndoRecord{};
 
 	if (PlayerController)
@@ -575,11 +1029,8 @@ bool UML_WavePropagationSubsystem::RestoreCollectibleDuringUndoMove(const FIntPo
 	if (!*CollectibleClass) return false;
 
 	// Resolve target tile from axial coordinate.
-	const TMap<FIntPoint, AML_Tile*> GridMap = Board->GetGridMap();
-	AML_Tile* const* TilePtr = GridMap.Find(Axial);
-	if (!TilePtr || !IsValid(*TilePtr)) return false;
-
-	AML_Tile* Tile = *TilePtr;
+	AML_Tile* Tile = Board->GetTileAt(Axial);
+	if (!IsValid(Tile)) return false;
 
 	// Prevent duplicates.
 	if (Tile->HasCollectible())
@@ -590,21 +1041,7 @@ bool UML_WavePropagationSubsystem::RestoreCollectibleDuringUndoMove(const FIntPo
 	// Spawn at tile world position (same rule as waves).
 	const FVector SpawnLocation = Tile->GetActorLocation();
 
-	FActorSpawnParameters Params;
-	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-
-	AML_Collectible* SpawnedCollectible = GetWorld()->SpawnActorDeferred<AML_Collectible>(CollectibleClass, FTransform(FRotator::ZeroRotator, SpawnLocation), nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
-	if (SpawnedCollectible)
-	{
-		// Configure BEFORE the spawn
-		SpawnedCollectible->SetOwningTile(*TilePtr);
-        
-		// Finish spawning
-		SpawnedCollectible->FinishSpawning(FTransform(FRotator::ZeroRotator, SpawnLocation));
-
-		//RecordSpawnedActor(SpawnedCollectible, DistanceFromOrigin);
-        
-	}
+	AML_Collectible* SpawnedCollectible = CollectiblePool->Acquire(CollectibleClass, SpawnLocation, Tile);
 
 	if (!IsValid(SpawnedCollectible))
 	{
@@ -644,9 +1081,9 @@ void UML_WavePropagationSubsystem::DestroyCollectibleActorOnTile(AML_Tile* Tile)
 	// Prefer the tile reference (O(1), deterministic).
 	if (AML_Collectible* C = Tile->CollectibleActor.Get())
 	{
-		if (IsValid(C))
+		if (C->GetOwningTile() == Tile)
 		{
-			C->Destroy();
+			CollectiblePool->Release(C);
 		}
 	}
 
@@ -11,6 +11,7 @@
 #include "GameFramework/Pawn.h"
 #include "Player/ML_PlayerCharacter.h"
 #include "Player/ML_PlayerController.h"
+#include "Subsystem/ML_BoardRegistrySubsystem.h"
 
 FML_GameResult UML_WinLoseSubsystem::CheckWinLose()
 {
@@ -58,6 +59,31 @@ bool UML_WinLoseSubsystem::CheckPlayerKilled(AML_Tile* CurrentTileOn)
 	return false;
 }
 
+namespace
+{
+	// Goals and allowed path types can be walked through
+	struct FGoalPathPolicy : FML_HexBFSPolicy
+	{
+		const FML_BoardView& Grid;
+		EML_TileType GoalType;
+		const TSet<EML_TileType>& AllowedSet;
+		bool bDisallowBlocked;
+
+		FGoalPathPolicy(const FML_BoardView& InGrid, const EML_TileType InGoalType, const TSet<EML_TileType>& InAllowedSet, const bool bInDisallowBlocked)
+			: Grid(InGrid), GoalType(InGoalType), AllowedSet(InAllowedSet), bDisallowBlocked(bInDisallowBlocked) {}
+
+		bool CanEnter(const int32 FromIndex, const int32 ToIndex) const
+		{
+			const AML_Tile* Tile = Grid.GetTile(ToIndex);
+			if (!IsValid(Tile)) return false;
+			if (bDisallowBlocked && Tile->IsBlocked()) return false;
+
+			const EML_TileType Type = Tile->GetCurrentType();
+			return (Type == GoalType) || AllowedSet.Contains(Type);
+		}
+	};
+}
+
 bool UML_WinLoseSubsystem::AreAllGoalsConnectedByAllowedPaths(
 	AML_BoardSpawner* Board,
 	EML_TileType GoalType,
@@ -67,132 +93,111 @@ bool UML_WinLoseSubsystem::AreAllGoalsConnectedByAllowedPaths(
 
 	if (!IsValid(Board)) return false;
 
-	const TMap<FIntPoint, AML_Tile*> Grid = Board->GetGridMap();
+	const FML_BoardView Grid = Board->GetBoardView();
 	if (Grid.Num() == 0) return false;
 
 	TSet<EML_TileType> AllowedSet;
 	for (EML_TileType T : AllowedPathTypes) AllowedSet.Add(T);
 
 	// Gather goals
-	TArray<FIntPoint> GoalAxials;
-	for (const auto& Pair : Grid)
+	TArray<int32> GoalIndices;
+	for (int32 Index = 0; Index < Grid.Num(); ++Index)
 	{
-		if (Pair.Value && Pair.Value->GetCurrentType() == GoalType)
+		const AML_Tile* Tile = Grid.GetTile(Index);
+		if (Tile && Tile->GetCurrentType() == GoalType)
 		{
-			GoalAxials.Add(Pair.Key);
+			GoalIndices.Add(Index);
 		}
 	}
 
-	if (GoalAxials.Num() <= 1)
+	if (GoalIndices.Num() <= 1)
 	{
 		// 0/1 goal = trivially connected. Keep PathTiles empty or add the goal if you prefer.
 		return true;
 	}
 
-	auto CanTraverse = [&](AML_Tile* Tile) -> bool
-	{
-		if (!IsValid(Tile)) return false;
-		const EML_TileType Type = Tile->GetCurrentType();
-		return (Type == GoalType) || AllowedSet.Contains(Type);
-	};
-
-	static const FIntPoint Dirs[6] = {
-		FIntPoint(1, 0),
-		FIntPoint(1, -1),
-		FIntPoint(0, -1),
-		FIntPoint(-1, 0),
-		FIntPoint(-1, 1),
-		FIntPoint(0, 1)
-	};
-
-	const FIntPoint Start = GoalAxials[0];
+	// BFS tree from the first goal, the scratch keeps the parent links to reconstruct paths
+	const int32 Start = GoalIndices[0];
+	FGoalPathPolicy Policy(Grid, GoalType, AllowedSet, false);
+	FML_HexBFS::Run(Grid.GetLayout(), Start, Policy, GoalScratch);
 
-	// BFS state
-	TSet<FIntPoint> Visited;
-	TQueue<FIntPoint> Queue;
-
-	// Parent links to reconstruct paths (BFS tree)
-	TMap<FIntPoint, FIntPoint> Parent; // child -> parent
-	Parent.Reserve(Grid.Num());
-
-	Visited.Add(Start);
-	Queue.Enqueue(Start);
-
-	// For goal checks
-	TSet<FIntPoint> GoalSet(GoalAxials);
-	TSet<FIntPoint> ReachedGoalSet;
-	ReachedGoalSet.Reserve(GoalAxials.Num());
-
-	while (!Queue.IsEmpty())
+	// If not all goals reached, fail and clear
+	for (const int32 GoalIndex : GoalIndices)
 	{
-		FIntPoint Current;
-		Queue.Dequeue(Current);
-
-		if (GoalSet.Contains(Current))
+		if (!GoalScratch.IsVisited(GoalIndex))
 		{
-			ReachedGoalSet.Add(Current);
+			PathTiles.Reset();
+			return false;
 		}
+	}
 
-		for (const FIntPoint& Dir : Dirs)
-		{
-			const FIntPoint Next = Current + Dir;
-			if (Visited.Contains(Next)) continue;
-
-			AML_Tile* const* NextPtr = Grid.Find(Next);
-			if (!NextPtr) continue;
-
-			AML_Tile* NextTile = *NextPtr;
-			if (!CanTraverse(NextTile)) continue;
+	// Reconstruct union of paths from each goal back to Start, stopping where a previous path was joined
+	TBitArray<> OnPath(false, Grid.Num());
+	TArray<int32> PathIndices;
 
-			Visited.Add(Next);
-			Parent.Add(Next, Current);
-			Queue.Enqueue(Next);
+	for (const int32 GoalIndex : GoalIndices)
+	{
+		for (int32 Node = GoalIndex; Node != INDEX_NONE && !OnPath[Node]; Node = GoalScratch.GetParent(Node))
+		{
+			OnPath[Node] = true;
+			PathIndices.Add(Node);
 		}
 	}
 
-	// If not all goals reached, fail and clear
-	if (ReachedGoalSet.Num() != GoalAxials.Num())
+	// Convert indices to tile pointers
+	PathTiles.Reserve(PathIndices.Num());
+	for (const int32 Index : PathIndices)
 	{
-		PathTiles.Reset();
-		return false;
+		if (AML_Tile* T = Grid.GetTile(Index))
+		{
+			PathTiles.Add(T);
+		}
 	}
 
-	// Reconstruct union of paths from each goal back to Start using Parent
-	TSet<FIntPoint> PathAxials;
-	PathAxials.Reserve(Grid.Num());
+	return true;
+}
 
-	PathAxials.Add(Start);
+bool UML_WinLoseSubsystem::AreAllGoalsConnectedOnState(
+	const FML_BoardState& State,
+	EML_TileType GoalType,
+	TConstArrayView<EML_TileType> AllowedPathTypes)
+{
+	if (!State.IsValid() || State.Num() == 0) return false;
 
-	for (const FIntPoint& GoalAxial : GoalAxials)
+	struct FStatePathPolicy : FML_HexBFSPolicy
 	{
-		FIntPoint Node = GoalAxial;
-		PathAxials.Add(Node);
+		const FML_BoardState& State;
+		EML_TileType GoalType;
+		TConstArrayView<EML_TileType> AllowedPathTypes;
+
+		FStatePathPolicy(const FML_BoardState& InState, const EML_TileType InGoalType, const TConstArrayView<EML_TileType> InAllowedPathTypes)
+			: State(InState), GoalType(InGoalType), AllowedPathTypes(InAllowedPathTypes) {}
 
-		// Walk back to Start
-		while (Node != Start)
+		bool CanEnter(const int32 FromIndex, const int32 ToIndex) const
 		{
-			const FIntPoint* P = Parent.Find(Node);
-			if (!P)
-			{
-				// Shouldn't happen if connected, but safety
-				PathTiles.Reset();
-				return false;
-			}
-			Node = *P;
-			PathAxials.Add(Node);
+			const EML_TileType Type = State.GetType(ToIndex);
+			return (Type == GoalType) || AllowedPathTypes.Contains(Type);
 		}
-	}
+	};
 
-	// Convert axial set to tile pointers
-	PathTiles.Reserve(PathAxials.Num());
-	for (const FIntPoint& A : PathAxials)
+	TArray<int32> GoalIndices;
+	for (int32 Index = 0; Index < State.Num(); ++Index)
 	{
-		if (AML_Tile* const* T = Grid.Find(A))
-		{
-			PathTiles.Add(*T);
-		}
+		if (State.GetType(Index) == GoalType) GoalIndices.Add(Index);
 	}
 
+	// 0/1 goal = trivially connected
+	if (GoalIndices.Num() <= 1) return true;
+
+	thread_local FML_HexBFSScratch Scratch;
+
+	FStatePathPolicy Policy(State, GoalType, AllowedPathTypes);
+	FML_HexBFS::Run(State.GetLayout(), GoalIndices[0], Policy, Scratch);
+
+	for (const int32 GoalIndex : GoalIndices)
+	{
+		if (!Scratch.IsVisited(GoalIndex)) return false;
+	}
 	return true;
 }
 
@@ -206,7 +211,7 @@ bool UML_WinLoseSubsystem::FindConnectedGoalGroups(
 	ConnectedGoalGroups.Reset();
 	if (!IsValid(Board)) return false;
 
-	const TMap<FIntPoint, AML_Tile*> Grid = Board->GetGridMap();
+	const FML_BoardView Grid = Board->GetBoardView();
 	if (Grid.Num() == 0) return false;
 
 	// Build allowed set
@@ -217,136 +222,60 @@ bool UML_WinLoseSubsystem::FindConnectedGoalGroups(
 		AllowedSet.Add(T);
 	}
 
-	auto CanTraverse = [&](AML_Tile* Tile) -> bool
-	{
-		if (!IsValid(Tile)) return false;
-		if (bDisallowBlocked && Tile->IsBlocked()) return false;
-
-		const EML_TileType Type = Tile->GetCurrentType();
-		return (Type == GoalType) || AllowedSet.Contains(Type);
-	};
-
-	static const FIntPoint Dirs[6] = {
-		FIntPoint( 1,  0),
-		FIntPoint( 1, -1),
-		FIntPoint( 0, -1),
-		FIntPoint(-1,  0),
-		FIntPoint(-1,  1),
-		FIntPoint( 0,  1)
-	};
-
 	// Gather goals
-	TArray<FIntPoint> GoalAxials;
-	GoalAxials.Reserve(32);
+	TArray<int32> GoalIndices;
+	GoalIndices.Reserve(32);
 
-	for (const auto& Pair : Grid)
+	for (int32 Index = 0; Index < Grid.Num(); ++Index)
 	{
-		if (Pair.Value && Pair.Value->GetCurrentType() == GoalType)
+		const AML_Tile* Tile = Grid.GetTile(Index);
+		if (Tile && Tile->GetCurrentType() == GoalType)
 		{
-			if (!bDisallowBlocked || !Pair.Value->IsBlocked())
+			if (!bDisallowBlocked || !Tile->IsBlocked())
 			{
-				GoalAxials.Add(Pair.Key);
+				GoalIndices.Add(Index);
 			}
 		}
 	}
 
 	// If you pass MinGoalsInGroup, for "path between 2 goals" it only makes sense as >= 2.
 	const int32 RequiredGoalsPerPath = FMath::Max(2, MinGoalsInGroup);
-	if (GoalAxials.Num() < RequiredGoalsPerPath) return false;
-
-	// For faster membership testing
-	TSet<FIntPoint> GoalSet;
-	GoalSet.Reserve(GoalAxials.Num());
-	for (const FIntPoint& A : GoalAxials) GoalSet.Add(A);
-
-	// Helper to reconstruct path from Parent map (Target -> Start)
-	auto ReconstructPath = [&](const FIntPoint& Start, const FIntPoint& Target, const TMap<FIntPoint, FIntPoint>& Parent, TArray<AML_Tile*>& OutTiles) -> bool
-	{
-		OutTiles.Reset();
-
-		// Walk backwards Target -> Start
-		TArray<FIntPoint> Axials;
-		FIntPoint Node = Target;
-		Axials.Add(Node);
-
-		while (Node != Start)
-		{
-			const FIntPoint* P = Parent.Find(Node);
-			if (!P) return false;
-			Node = *P;
-			Axials.Add(Node);
-		}
-
-		Algo::Reverse(Axials);
+	if (GoalIndices.Num() < RequiredGoalsPerPath) return false;
 
-		OutTiles.Reserve(Axials.Num());
-		for (const FIntPoint& Ax : Axials)
-		{
-			if (AML_Tile* const* T = Grid.Find(Ax))
-			{
-				OutTiles.Add(*T);
-			}
-		}
-
-		return OutTiles.Num() > 0;
-	};
+	FGoalPathPolicy Policy(Grid, GoalType, AllowedSet, bDisallowBlocked);
+	TArray<int32> PathIndices;
 
 	// Generate one shortest path group for each connected pair (i < j)
-	for (int32 i = 0; i < GoalAxials.Num(); ++i)
+	for (int32 i = 0; i < GoalIndices.Num(); ++i)
 	{
-		const FIntPoint Start = GoalAxials[i];
+		const int32 Start = GoalIndices[i];
 
 		// BFS from this goal
-		TQueue<FIntPoint> Queue;
-		TSet<FIntPoint> Visited;
-		TMap<FIntPoint, FIntPoint> Parent;
-
-		Visited.Reserve(Grid.Num());
-		Parent.Reserve(Grid.Num());
-
-		Visited.Add(Start);
-		Queue.Enqueue(Start);
-
-		while (!Queue.IsEmpty())
-		{
-			FIntPoint Current;
-			Queue.Dequeue(Current);
-
-			for (const FIntPoint& Dir : Dirs)
-			{
-				const FIntPoint Next = Current + Dir;
-				if (Visited.Contains(Next)) continue;
-
-				AML_Tile* const* NextPtr = Grid.Find(Next);
-				if (!NextPtr) continue;
-
-				AML_Tile* NextTile = *NextPtr;
-				if (!CanTraverse(NextTile)) continue;
-
-				Visited.Add(Next);
-				Parent.Add(Next, Current);
-				Queue.Enqueue(Next);
-			}
-		}
+		FML_HexBFS::Run(Grid.GetLayout(), Start, Policy, GoalScratch);
 
 		// For every other goal j > i, if reachable, add a distinct path group
-		for (int32 j = i + 1; j < GoalAxials.Num(); ++j)
+		for (int32 j = i + 1; j < GoalIndices.Num(); ++j)
 		{
-			const FIntPoint Target = GoalAxials[j];
-			if (Target == Start) continue;
-
-			// If unreachable, Parent won't contain it (unless it's Start)
-			if (!Parent.Contains(Target)) continue;
+			const int32 Target = GoalIndices[j];
 
-			TArray<AML_Tile*> Path;
-			if (!ReconstructPath(Start, Target, Parent, Path)) continue;
+			// Start -> Target, empty if unreachable
+			GoalScratch.GetPathTo(Target, PathIndices);
+			if (PathIndices.Num() == 0) continue;
 
 			// Build one group = one path between 2 goals
 			FML_TileGroup Group;
-			Group.Tiles = MoveTemp(Path);
+			Group.Tiles.Reserve(PathIndices.Num());
+			for (const int32 Index : PathIndices)
+			{
+				if (AML_Tile* T = Grid.GetTile(Index))
+				{
+					Group.Tiles.Add(T);
+				}
+			}
+			if (Group.Tiles.Num() == 0) continue;
 
-			AML_Tile* GoalA = Grid.FindRef(Start);
-			AML_Tile* GoalB = Grid.FindRef(Target);
+			AML_Tile* GoalA = Grid.GetTile(Start);
+			AML_Tile* GoalB = Grid.GetTile(Target);
 
 			if (IsValid(GoalA)) Group.Goals.Add(GoalA);
 			if (IsValid(GoalB)) Group.Goals.Add(GoalB);
@@ -384,11 +313,12 @@ AML_Tile* UML_WinLoseSubsystem::GetPlayerCurrentTile() const
 AML_BoardSpawner* UML_WinLoseSubsystem::FindBoardSpawner() const
 {
 	AML_Tile* ChildTile = GetPlayerCurrentTile();
+	if (!ChildTile) return nullptr;
 
-	AActor* BoardActor = ChildTile->GetAttachParentActor();
-	if (!BoardActor) return nullptr;
+	const UML_BoardRegistrySubsystem* Registry = GetWorld()->GetSubsystem<UML_BoardRegistrySubsystem>();
+	if (!Registry) return nullptr;
 
-	AML_BoardSpawner* RetrivedBoardSpawner = Cast<AML_BoardSpawner>(BoardActor);
+	AML_BoardSpawner* RetrivedBoardSpawner = Registry->FindBoardForTile(ChildTile);
 	if (!RetrivedBoardSpawner) return nullptr;
 
 	UE_LOG(LogTemp, Log, TEXT("Board found: %s at %s"),
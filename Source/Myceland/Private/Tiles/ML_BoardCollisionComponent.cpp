@@ -0,0 +1,119 @@
+﻿// Copyright Myceland Team, All Rights Reserved.
+
+
+#include "Tiles/ML_BoardCollisionComponent.h"
+
+#include "PhysicsEngine/BodySetup.h"
+
+UML_BoardCollisionComponent::UML_BoardCollisionComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+
+	// The prisms are laid out in board space: only the board location matters
+	SetUsingAbsoluteRotation(true);
+	SetUsingAbsoluteScale(true);
+
+	// Blocks everything like the floor it replaces (HighlightTileMesh), the owner narrows the responses of a blocked tile set
+	SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+	SetCollisionObjectType(ECC_WorldStatic);
+	SetCollisionResponseToAllChannels(ECR_Block);
+	SetGenerateOverlapEvents(false);
+	SetHiddenInGame(true);
+}
+
+Chaos::FConvexPtr UML_BoardCollisionComponent::MakeHexPrism(const float Radius, const float AngleOffset, const float Bottom, const float Top, TArray<FVector>& OutVertices)
+{
+	OutVertices.Reset(12);
+	TArray<Chaos::FConvex::FVec3Type> ConvexVertices;
+	ConvexVertices.Reserve(12);
+
+	for (int32 Corner = 0; Corner < 6; ++Corner)
+	{
+		const float Angle = FMath::DegreesToRadians(AngleOffset + 60.f * Corner);
+		const float X = Radius * FMath::Cos(Angle);
+		const float Y = Radius * FMath::Sin(Angle);
+
+		OutVertices.Add(FVector(X, Y, Bottom));
+		OutVertices.Add(FVector(X, Y, Top));
+	}
+
+	for (const FVector& Vertex : OutVertices)
+	{
+		ConvexVertices.Add(Chaos::FConvex::FVec3Type(Vertex.X, Vertex.Y, Vertex.Z));
+	}
+
+	return Chaos::FConvexPtr(new Chaos::FConvex(ConvexVertices, 0.f));
+}
+
+void UML_BoardCollisionComponent::Build(const TConstArrayView<FVector> InTileCenters, const TBitArray<>& InEnabledTiles)
+{
+	if (!BodySetup)
+	{
+		BodySetup = NewObject<UBodySetup>(this, NAME_None, RF_Transient);
+		BodySetup->BodySetupGuid = FGuid::NewGuid();
+		BodySetup->CollisionTraceFlag = CTF_UseSimpleAsComplex;
+
+		// The convex is built here, nothing to cook
+		BodySetup->bNeverNeedsCookedCollisionData = true;
+	}
+
+	// Flat top hexagons have a corner on +X, pointy top ones on +Y (see AML_BoardSpawner::AxialToWorld)
+	const float AngleOffset = bFlatTop ? 0.f : 30.f;
+	PrismConvex = MakeHexPrism(PrismRadius, AngleOffset, PrismBottom, PrismTop, PrismVertices);
+
+	TileCenters.Reset(InTileCenters.Num());
+	TileCenters.Append(InTileCenters.GetData(), InTileCenters.Num());
+	EnabledTiles.Init(false, TileCenters.Num());
+	for (TConstSetBitIterator<> It(InEnabledTiles); It && It.GetIndex() < TileCenters.Num(); ++It)
+		EnabledTiles[It.GetIndex()] = true;
+
+	BodySetup->bCreatedPhysicsMeshes = true;
+	bPhysicsStateDirty = true;
+	CommitChanges();
+}
+
+void UML_BoardCollisionComponent::SetTileEnabled(const int32 Index, const bool bEnabled)
+{
+	if (!EnabledTiles.IsValidIndex(Index) || EnabledTiles[Index] == bEnabled) return;
+
+	EnabledTiles[Index] = bEnabled;
+	bPhysicsStateDirty = true;
+}
+
+void UML_BoardCollisionComponent::CommitChanges()
+{
+	if (!bPhysicsStateDirty || !BodySetup) return;
+	bPhysicsStateDirty = false;
+
+	// The elements only differ by their transform, rebuilding the list costs less than the physics update below
+	TArray<FKConvexElem>& Elements = BodySetup->AggGeom.ConvexElems;
+	Elements.Reset();
+	for (TConstSetBitIterator<> It(EnabledTiles); It; ++It)
+	{
+		FKConvexElem& Element = Elements.AddDefaulted_GetRef();
+		Element.VertexData = PrismVertices;
+		Element.UpdateElemBox();
+		Element.SetTransform(FTransform(TileCenters[It.GetIndex()]));
+		Element.SetConvexMeshObject(Chaos::FConvexPtr(PrismConvex));
+	}
+
+	// One body for the whole set: one physics scene update whatever the number of changed tiles
+	UpdateBounds();
+	RecreatePhysicsState();
+}
+
+bool UML_BoardCollisionComponent::ShouldCreatePhysicsState() const
+{
+	// No blocked tile left: no body rather than a body without shapes
+	return Super::ShouldCreatePhysicsState() && BodySetup && BodySetup->AggGeom.GetElementCount() > 0;
+}
+
+FBoxSphereBounds UML_BoardCollisionComponent::CalcBounds(const FTransform& LocalToWorld) const
+{
+	if (!BodySetup || BodySetup->AggGeom.GetElementCount() == 0)
+		return FBoxSphereBounds(LocalToWorld.GetLocation(), FVector::ZeroVector, 0.f);
+
+	FBoxSphereBounds Bounds;
+	BodySetup->AggGeom.CalcBoxSphereBounds(Bounds, LocalToWorld);
+	return Bounds;
+}
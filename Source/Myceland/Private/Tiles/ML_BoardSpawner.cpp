@@ -4,8 +4,18 @@
 #include "Tiles/ML_BoardSpawner.h"
 #include "Tiles/ML_Tile.h"
 #include "Engine/World.h"
-#include "EngineUtils.h"
+#include "TimerManager.h"
+#include "Algo/StableSort.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "Components/ChildActorComponent.h"
 #include "Components/StaticMeshComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Data Asset/ML_BiomeTileSet.h"
+#include "Subsystem/ML_BoardRegistrySubsystem.h"
+#include "Subsystem/ML_CollectiblePoolSubsystem.h"
+#include "Tiles/ML_BoardCollisionComponent.h"
+#include "Tiles/ML_TileBase.h"
 #include "Tiles/TileBase/ML_TileGrass.h"
 #include "Tiles/TileBase/ML_TileParasite.h"
 #include "Tiles/TileBase/ML_TileWater.h"
@@ -18,10 +28,46 @@ AML_BoardSpawner::AML_BoardSpawner()
 
 void AML_BoardSpawner::Destroyed()
 {
+	GetWorldTimerManager().ClearTimer(CollisionFlushTimerHandle);
+	DirtyCollisionTiles.Empty();
+	PendingVisualCollision.Empty();
+
 	ClearTiles();
 	Super::Destroyed();
 }
 
+#if WITH_EDITOR
+void AML_BoardSpawner::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	const FName PropertyName = PropertyChangedEvent.GetMemberPropertyName();
+	if (PropertyName == GET_MEMBER_NAME_CHECKED(AML_BoardSpawner, bUseInstancedRendering) ||
+		PropertyName == GET_MEMBER_NAME_CHECKED(AML_BoardSpawner, bPoolTileVisuals))
+	{
+		RebuildTileVisuals();
+	}
+}
+#endif
+
+void AML_BoardSpawner::PostRegisterAllComponents()
+{
+	Super::PostRegisterAllComponents();
+
+	UWorld* World = GetWorld();
+	UML_BoardRegistrySubsystem* Registry = World ? World->GetSubsystem<UML_BoardRegistrySubsystem>() : nullptr;
+	if (Registry) Registry->RegisterBoard(this);
+}
+
+void AML_BoardSpawner::PostUnregisterAllComponents()
+{
+	UWorld* World = GetWorld();
+	UML_BoardRegistrySubsystem* Registry = World ? World->GetSubsystem<UML_BoardRegistrySubsystem>() : nullptr;
+	if (Registry) Registry->UnregisterBoard(this);
+
+	Super::PostUnregisterAllComponents();
+}
+
 void AML_BoardSpawner::BeginPlay()
 {
 	Super::BeginPlay();
@@ -29,7 +75,16 @@ void AML_BoardSpawner::BeginPlay()
 	ensureMsgf(BiomeTileSet, TEXT("BiomeTileSet is not set for board : %s"), *GetName());
 	if (!BiomeTileSet) return;
 	
-	UpdateCurrentGrid();
+	PrewarmVisualPool();
+	if (UML_CollectiblePoolSubsystem* CollectiblePool = GetWorld()->GetSubsystem<UML_CollectiblePoolSubsystem>())
+	{
+		CollectiblePool->Prewarm(BiomeTileSet->GetCollectibleClass(), PrewarmCollectibles);
+	}
+	
+	if (bAsyncSpawn)
+		BeginAsyncSpawn();
+	else
+		UpdateCurrentGrid();
 }
 
 void AML_BoardSpawner::RebuildGrid()
@@ -44,17 +99,39 @@ void AML_BoardSpawner::RebuildGrid()
 }
 
 void AML_BoardSpawner::UpdateCurrentGrid()
+{
+	CancelAsyncSpawn();
+
+	TArray<FML_PendingTile> Pending;
+	GatherPendingTiles(Pending);
+
+	for (const FML_PendingTile& Tile : Pending)
+	{
+		ProcessPendingTile(Tile);
+	}
+
+	BuildBoardLayout();
+}
+
+void AML_BoardSpawner::GatherPendingTiles(TArray<FML_PendingTile>& OutPending)
 {
 	UWorld* World = GetWorld();
 	if (!World) return;
 
 	// Rebuild map from existing tiles owned by this spawner.
-	GridMap.Empty();
+	TMap<FIntPoint, AML_Tile*> ExistingTiles;
 	SpawnedTiles.Empty();
+	ResetBoardLayout();
+	bBoardReady = false;
+
+	TArray<AML_Tile*> OwnedTiles;
+	if (UML_BoardRegistrySubsystem* Registry = World->GetSubsystem<UML_BoardRegistrySubsystem>())
+	{
+		Registry->GetTilesOfBoard(this, OwnedTiles);
+	}
 
-	for (TActorIterator<AML_Tile> It(World); It; ++It)
+	for (AML_Tile* Tile : OwnedTiles)
 	{
-		AML_Tile* Tile = *It;
 		if (!IsValid(Tile)) continue;
 		if (Tile->GetOwner() != this) continue;
 
@@ -69,24 +146,23 @@ void AML_BoardSpawner::UpdateCurrentGrid()
 			}
 		}
 
-		if (GridMap.Contains(Axial))
+		if (ExistingTiles.Contains(Axial))
 		{
 			const FIntPoint Derived = WorldToAxial(Tile->GetActorLocation());
-			if (!GridMap.Contains(Derived))
+			if (!ExistingTiles.Contains(Derived))
 			{
 				Axial = Derived;
 				Tile->SetAxialCoord(Axial);
 			}
 		}
 
-		if (GridMap.Contains(Axial))
+		if (ExistingTiles.Contains(Axial))
 		{
 			Tile->Destroy();
 			continue;
 		}
 
-		GridMap.Add(Axial, Tile);
-		SpawnedTiles.Add(Tile);
+		ExistingTiles.Add(Axial, Tile);
 	}
 
 	// Determine all desired axial coordinates
@@ -124,60 +200,125 @@ void AML_BoardSpawner::UpdateCurrentGrid()
 	}
 
 	// Remove tiles that are no longer part of the desired grid
-	for (const TPair<FIntPoint, TObjectPtr<AML_Tile>>& Pair : GridMap)
+	for (const TPair<FIntPoint, AML_Tile*>& Pair : ExistingTiles)
 	{
 		if (DesiredAxials.Contains(Pair.Key)) continue;
 		if (Pair.Value) Pair.Value->Destroy();
 	}
 
 	// Spawn new tiles or reattach existing
-	FActorSpawnParameters Params;
-	Params.Owner = this;
-	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-
-	TMap<FIntPoint, TObjectPtr<AML_Tile>> NewTilesByAxial;
-	NewTilesByAxial.Reserve(DesiredAxials.Num());
+	OutPending.Reserve(DesiredAxials.Num());
+	SpawnedTiles.Reserve(DesiredAxials.Num());
 
 	for (const FIntPoint& Axial : DesiredAxials)
 	{
-		AML_Tile* Tile = nullptr;
+		FML_PendingTile& Pending = OutPending.AddDefaulted_GetRef();
+		Pending.Axial = Axial;
+		Pending.Tile = ExistingTiles.FindRef(Axial);
+	}
+}
+
+void AML_BoardSpawner::ProcessPendingTile(const FML_PendingTile& Pending)
+{
+	UWorld* World = GetWorld();
+	if (!World) return;
+
+	const FIntPoint& Axial = Pending.Axial;
+	AML_Tile* Tile = nullptr;
+	
+	// Tile exists
+	if (Pending.Tile.IsValid())
+	{
+		Tile = Pending.Tile.Get();
+
+		// Reattach to the board spawner without changing scale/rotation
+		Tile->AttachToActor(this, FAttachmentTransformRules::KeepWorldTransform);
+		Tile->SetAxialCoord(Axial);
+
+		Tile->Initialize(BiomeTileSet);
+	}
+	// New tile
+	else if (TileClass)
+	{
+		FActorSpawnParameters Params;
+		Params.Owner = this;
+		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		const FVector Location = AxialToWorld(Axial.X, Axial.Y);
+		const FTransform SpawnTransform(FRotator::ZeroRotator, Location, TileScale);
+		Tile = World->SpawnActor<AML_Tile>(TileClass, SpawnTransform, Params);
+		if (!Tile) return;
+
+		Tile->AttachToActor(this, FAttachmentTransformRules::KeepRelativeTransform);
+		Tile->SetAxialCoord(Axial);
 		
-		// Tile exists
-		if (const TObjectPtr<AML_Tile>* Found = GridMap.Find(Axial))
-		{
-			Tile = Found->Get();
-			if (!Tile) continue;
+		Tile->Initialize(BiomeTileSet);
+	}
 
-			// Reattach to the board spawner without changing scale/rotation
-			Tile->AttachToActor(this, FAttachmentTransformRules::KeepWorldTransform);
-			Tile->SetAxialCoord(Axial);
+	if (Tile) SpawnedTiles.Add(Tile);
+}
 
-			Tile->Initialize(BiomeTileSet);
-		}
-		// New tile
-		else if (TileClass)
-		{
-			const FVector Location = AxialToWorld(Axial.X, Axial.Y);
-			const FTransform SpawnTransform(FRotator::ZeroRotator, Location, TileScale);
-			Tile = World->SpawnActor<AML_Tile>(TileClass, SpawnTransform, Params);
-			if (!Tile) continue;
+void AML_BoardSpawner::BeginAsyncSpawn()
+{
+	CancelAsyncSpawn();
+	GatherPendingTiles(AsyncPendingTiles);
 
-			Tile->AttachToActor(this, FAttachmentTransformRules::KeepRelativeTransform);
-			Tile->SetAxialCoord(Axial);
-			
-			Tile->Initialize(BiomeTileSet);
+	// Rings around the player: the tiles the player sees first come first
+	const FIntPoint Focus = GetAsyncSpawnFocus();
+	auto HexDistance = [&Focus](const FIntPoint& Axial)
+	{
+		const FIntPoint Delta = Axial - Focus;
+		return (FMath::Abs(Delta.X) + FMath::Abs(Delta.Y) + FMath::Abs(Delta.X + Delta.Y)) / 2;
+	};
+
+	Algo::StableSortBy(AsyncPendingTiles, [&HexDistance](const FML_PendingTile& Pending) { return HexDistance(Pending.Axial); });
+
+	ContinueAsyncSpawn();
+}
+
+void AML_BoardSpawner::ContinueAsyncSpawn()
+{
+	const double Deadline = FPlatformTime::Seconds() + AsyncSpawnBudgetMs / 1000.0;
+
+	// Always make progress, even with a tiny budget. Nothing pending (empty grid) goes straight to the layout.
+	if (AsyncPendingCursor < AsyncPendingTiles.Num())
+	{
+		do
+		{
+			ProcessPendingTile(AsyncPendingTiles[AsyncPendingCursor++]);
 		}
+		while (AsyncPendingCursor < AsyncPendingTiles.Num() && FPlatformTime::Seconds() < Deadline);
+	}
 
-		if (Tile) NewTilesByAxial.Add(Axial, Tile);
+	if (AsyncPendingCursor < AsyncPendingTiles.Num())
+	{
+		AsyncSpawnTimerHandle = GetWorldTimerManager().SetTimerForNextTick(this, &AML_BoardSpawner::ContinueAsyncSpawn);
+		return;
 	}
 
-	GridMap = MoveTemp(NewTilesByAxial);
-	SpawnedTiles.Empty();
-	SpawnedTiles.Reserve(GridMap.Num());
-	for (const TPair<FIntPoint, TObjectPtr<AML_Tile>>& Pair : GridMap)
+	AsyncPendingTiles.Empty();
+	AsyncPendingCursor = 0;
+
+	BuildBoardLayout();
+}
+
+void AML_BoardSpawner::CancelAsyncSpawn()
+{
+	if (UWorld* World = GetWorld())
 	{
-		SpawnedTiles.Add(Pair.Value);
+		World->GetTimerManager().ClearTimer(AsyncSpawnTimerHandle);
 	}
+
+	AsyncPendingTiles.Empty();
+	AsyncPendingCursor = 0;
+}
+
+FIntPoint AML_BoardSpawner::GetAsyncSpawnFocus() const
+{
+	const APlayerController* PlayerController = GetWorld() ? GetWorld()->GetFirstPlayerController() : nullptr;
+	const APawn* Pawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+
+	return Pawn ? WorldToAxial(Pawn->GetActorLocation()) : FIntPoint::ZeroValue;
 }
 
 void AML_BoardSpawner::ClearTiles()
@@ -185,10 +326,17 @@ void AML_BoardSpawner::ClearTiles()
 	UWorld* World = GetWorld();
 	if (!World) return;
 
-	// Destroy all tiles where owner=this
-	for (TActorIterator<AML_Tile> It(World); It; ++It)
+	CancelAsyncSpawn();
+
+	// Destroy all tiles where owner=this (copied, destroying a tile unregisters it)
+	TArray<AML_Tile*> OwnedTiles;
+	if (UML_BoardRegistrySubsystem* Registry = World->GetSubsystem<UML_BoardRegistrySubsystem>())
+	{
+		Registry->GetTilesOfBoard(this, OwnedTiles);
+	}
+
+	for (AML_Tile* Tile : OwnedTiles)
 	{
-		AML_Tile* Tile = *It;
 		if (!IsValid(Tile)) continue;
 
 		if (Tile->GetOwner() == this)
@@ -198,40 +346,500 @@ void AML_BoardSpawner::ClearTiles()
 	}
 
 	SpawnedTiles.Empty();
-	GridMap.Empty();
+	ResetBoardLayout();
+	DestroyVisualPool();
+	bBoardReady = false;
 }
 
-TArray<AML_Tile*> AML_BoardSpawner::GetNeighbors(AML_Tile* CenterTile)
+void AML_BoardSpawner::BuildBoardLayout()
+{
+	TArray<FIntPoint> Axials;
+	Axials.Reserve(SpawnedTiles.Num());
+	for (const TObjectPtr<AML_Tile>& Tile : SpawnedTiles)
+	{
+		if (Tile) Axials.Add(Tile->GetAxialCoord());
+	}
+
+	const TSharedRef<FML_BoardLayout> NewLayout = MakeShared<FML_BoardLayout>();
+	NewLayout->Build(Axials);
+	Layout = NewLayout;
+
+	// Reorder the tiles so that SpawnedTiles[Index] matches the layout
+	TArray<TObjectPtr<AML_Tile>> OrderedTiles;
+	OrderedTiles.SetNum(Layout->Num());
+	for (const TObjectPtr<AML_Tile>& Tile : SpawnedTiles)
+	{
+		if (!Tile) continue;
+
+		const int32 Index = Layout->IndexOf(Tile->GetAxialCoord());
+		Tile->SetBoardIndex(Index);
+		OrderedTiles[Index] = Tile;
+	}
+
+	SpawnedTiles = MoveTemp(OrderedTiles);
+
+	BoardState.Init(Layout);
+	for (const TObjectPtr<AML_Tile>& Tile : SpawnedTiles)
+	{
+		SyncTileState(Tile);
+	}
+
+	RebuildTileVisuals();
+	RebuildBoardCollision();
+
+	bBoardReady = true;
+	OnBoardReady.Broadcast(this);
+}
+
+void AML_BoardSpawner::ResetBoardLayout()
 {
-	if (!CenterTile) return TArray<AML_Tile*>();
+	Layout = MakeShared<FML_BoardLayout>();
+	BoardState.Init(Layout);
+	RebuildTileVisuals();
+}
 
-	const FIntPoint CenterAxial = CenterTile->GetAxialCoord();
-	TArray<AML_Tile*> Neighbors;
-	Neighbors.Reserve(6);
+void AML_BoardSpawner::RebuildTileVisuals()
+{
+	for (const TPair<EML_TileType, TObjectPtr<UHierarchicalInstancedStaticMeshComponent>>& Pair : TypeInstances)
+	{
+		if (Pair.Value) Pair.Value->ClearInstances();
+	}
+	FreeInstances.Reset();
+	TileInstances.Reset();
+
+	// Release the visuals of destroyed tiles, the others keep theirs while the layout is rebuilt
+	const bool bPoolVisuals = UsesVisualPool();
+	for (auto It = TileVisuals.CreateIterator(); It; ++It)
+	{
+		if (bPoolVisuals && IsValid(It.Key()) && It.Key()->GetOwner() == this) continue;
+
+		ReleaseVisual(It.Value());
+		It.RemoveCurrent();
+	}
 
-	for (const FIntPoint& Dir : Directions)
+	TileInstances.SetNum(bUseInstancedRendering ? SpawnedTiles.Num() : 0);
+	for (const TObjectPtr<AML_Tile>& Tile : SpawnedTiles)
 	{
-		const FIntPoint NeighborKey = CenterAxial + Dir;
-		if (const TObjectPtr<AML_Tile>* Found = GridMap.Find(NeighborKey))
+		if (!Tile) continue;
+
+		UChildActorComponent* TileChildActor = Tile->GetTileChildActor();
+		const TSubclassOf<AML_TileBase> VisualClass = Tile->GetTypeVisualClass();
+
+		if ((bUseInstancedRendering || bPoolVisuals) && UpdateTileVisual(Tile, VisualClass))
+		{
+			if (TileChildActor->GetChildActorClass()) TileChildActor->SetChildActorClass(nullptr);
+		}
+		// Back to its child actor (instancing or pooling turned off, no instance for its type)
+		else if (TileChildActor->GetChildActorClass() != VisualClass)
 		{
-			Neighbors.Add(Found->Get());
+			Tile->SetChildActorVisual(VisualClass);
 		}
+	}
+}
+
+bool AML_BoardSpawner::UpdateTileVisual(AML_Tile* Tile, const TSubclassOf<AML_TileBase> VisualClass)
+{
+	if (UpdateTileInstance(Tile)) return true;
+	if (!UsesVisualPool() || GetTileIndex(Tile) == INDEX_NONE) return false;
+
+	// No class to show: the tile child actor takes over, the pooled visual must not stay on screen
+	if (!VisualClass)
+	{
+		TObjectPtr<AML_TileBase> StaleVisual;
+		if (TileVisuals.RemoveAndCopyValue(Tile, StaleVisual))
+			ReleaseVisual(StaleVisual);
+		return false;
+	}
+
+	TObjectPtr<AML_TileBase>& Visual = TileVisuals.FindOrAdd(Tile);
+	if (IsValid(Visual) && Visual->GetClass() == VisualClass) return true;
+
+	ReleaseVisual(Visual);
+	Visual = AcquireVisual(VisualClass, Tile);
+	return Visual != nullptr;
+}
+
+UHierarchicalInstancedStaticMeshComponent* AML_BoardSpawner::GetOrCreateTypeInstances(const EML_TileType Type)
+{
+	if (const TObjectPtr<UHierarchicalInstancedStaticMeshComponent>* Found = TypeInstances.Find(Type))
+		return *Found;
+
+	const UStaticMeshComponent* Template = BiomeTileSet ? BiomeTileSet->GetGroundTemplate(Type) : nullptr;
+	if (!Template) return nullptr;
+
+	UHierarchicalInstancedStaticMeshComponent* Instances = NewObject<UHierarchicalInstancedStaticMeshComponent>(this, NAME_None, RF_Transient);
+	Instances->SetStaticMesh(Template->GetStaticMesh());
+	for (int32 MaterialIndex = 0; MaterialIndex < Template->GetNumMaterials(); ++MaterialIndex)
+	{
+		Instances->SetMaterial(MaterialIndex, Template->GetMaterial(MaterialIndex));
+	}
+
+	// Gameplay collision and cursor traces stay on the tiles
+	Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Instances->SetGenerateOverlapEvents(false);
+
+	if (USceneComponent* Root = GetRootComponent())
+		Instances->SetupAttachment(Root);
+	else
+		SetRootComponent(Instances);
+
+	Instances->RegisterComponent();
+	AddInstanceComponent(Instances);
+
+	TypeInstances.Add(Type, Instances);
+	return Instances;
+}
+
+void AML_BoardSpawner::ReleaseTileInstance(FML_TileInstance& Instance)
+{
+	if (Instance.Id == INDEX_NONE) return;
+
+	if (UHierarchicalInstancedStaticMeshComponent* Instances = TypeInstances.FindRef(Instance.Type))
+	{
+		// Collapse instead of RemoveInstance, which would shift the ids of the other tiles
+		FTransform Collapsed;
+		Instances->GetInstanceTransform(Instance.Id, Collapsed, true);
+		Collapsed.SetScale3D(FVector::ZeroVector);
+		Instances->UpdateInstanceTransform(Instance.Id, Collapsed, true, true, true);
+
+		FreeInstances.FindOrAdd(Instance.Type).Add(Instance.Id);
+	}
+
+	Instance.Id = INDEX_NONE;
+}
+
+bool AML_BoardSpawner::UpdateTileInstance(const AML_Tile* Tile)
+{
+	if (!bUseInstancedRendering) return false;
+
+	const int32 Index = GetTileIndex(Tile);
+	if (!TileInstances.IsValidIndex(Index)) return false;
+
+	FML_TileInstance& Instance = TileInstances[Index];
+	const EML_TileType NewType = Tile->GetCurrentType();
+	if (Instance.Id != INDEX_NONE && Instance.Type == NewType) return true;
+
+	ReleaseTileInstance(Instance);
+
+	UHierarchicalInstancedStaticMeshComponent* Instances = GetOrCreateTypeInstances(NewType);
+	if (!Instances) return false;
+
+	// Same placement as the ground mesh of the child actor
+	const UStaticMeshComponent* Template = BiomeTileSet->GetGroundTemplate(NewType);
+	const FTransform InstanceTransform = Template->GetRelativeTransform() * Tile->GetTileChildActor()->GetComponentTransform();
+
+	Instance.Type = NewType;
+	TArray<int32>* Free = FreeInstances.Find(NewType);
+	if (Free && Free->Num() > 0)
+	{
+		Instance.Id = Free->Pop(EAllowShrinking::No);
+		Instances->UpdateInstanceTransform(Instance.Id, InstanceTransform, true, true, true);
+	}
+	else
+	{
+		Instance.Id = Instances->AddInstance(InstanceTransform, true);
+	}
+
+	return true;
+}
+
+bool AML_BoardSpawner::UsesVisualPool() const
+{
+	const UWorld* World = GetWorld();
+	return bPoolTileVisuals && !bUseInstancedRendering && World && World->IsGameWorld();
+}
+
+void AML_BoardSpawner::PrewarmVisualPool()
+{
+	if (!UsesVisualPool() || !BiomeTileSet) return;
+
+	for (const EML_TileType Type : { EML_TileType::Dirt, EML_TileType::Grass, EML_TileType::Parasite, EML_TileType::Water })
+	{
+		const TSubclassOf<AML_TileBase> VisualClass = BiomeTileSet->GetClassFromTileType(Type);
+		if (!VisualClass) continue;
+
+		FML_TileVisualPool& Pool = VisualPools.FindOrAdd(VisualClass);
+		while (Pool.Free.Num() < PrewarmVisualsPerType)
+		{
+			AML_TileBase* Visual = SpawnPooledVisual(VisualClass);
+			if (!Visual) break;
+			Pool.Free.Add(Visual);
+		}
+	}
+}
+
+AML_TileBase* AML_BoardSpawner::SpawnPooledVisual(const TSubclassOf<AML_TileBase> VisualClass)
+{
+	UWorld* World = GetWorld();
+	if (!World || !VisualClass) return nullptr;
+
+	FActorSpawnParameters Params;
+	Params.Owner = this;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	AML_TileBase* Visual = World->SpawnActor<AML_TileBase>(VisualClass, GetActorTransform(), Params);
+	if (!Visual) return nullptr;
+
+	Visual->SetActorHiddenInGame(true);
+	Visual->SetActorEnableCollision(false);
+	Visual->SetActorTickEnabled(false);
+	return Visual;
+}
+
+AML_TileBase* AML_BoardSpawner::AcquireVisual(const TSubclassOf<AML_TileBase> VisualClass, AML_Tile* Tile)
+{
+	AML_TileBase* Visual = nullptr;
+	if (FML_TileVisualPool* Pool = VisualPools.Find(VisualClass))
+	{
+		while (!Visual && Pool->Free.Num() > 0)
+		{
+			Visual = Pool->Free.Pop(EAllowShrinking::No);
+			if (!IsValid(Visual)) Visual = nullptr;
+		}
+	}
+
+	if (!Visual) Visual = SpawnPooledVisual(VisualClass);
+	if (!Visual) return nullptr;
+
+	// Owned by the tile so cursor hits on the visual resolve to the tile (see AML_PlayerController::GetTileUnderCursor)
+	Visual->SetOwner(Tile);
+	Visual->AttachToComponent(Tile->GetTileChildActor(), FAttachmentTransformRules::SnapToTargetIncludingScale);
+	Visual->SetActorHiddenInGame(false);
+	SetVisualCollision(Visual, !BoardCollision);
+	Visual->SetActorTickEnabled(true);
+	return Visual;
+}
+
+void AML_BoardSpawner::ReleaseVisual(AML_TileBase* Visual)
+{
+	if (!IsValid(Visual)) return;
+
+	Visual->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+	Visual->SetActorHiddenInGame(true);
+	SetVisualCollision(Visual, false);
+	Visual->SetActorTickEnabled(false);
+	Visual->SetOwner(this);
+
+	VisualPools.FindOrAdd(Visual->GetClass()).Free.Add(Visual);
+}
+
+void AML_BoardSpawner::DestroyVisualPool()
+{
+	for (const TPair<TObjectPtr<AML_Tile>, TObjectPtr<AML_TileBase>>& Pair : TileVisuals)
+	{
+		if (IsValid(Pair.Value)) Pair.Value->Destroy();
+	}
+	TileVisuals.Empty();
+
+	for (const TPair<TSubclassOf<AML_TileBase>, FML_TileVisualPool>& Pair : VisualPools)
+	{
+		for (AML_TileBase* Visual : Pair.Value.Free)
+		{
+			if (IsValid(Visual)) Visual->Destroy();
+		}
+	}
+	VisualPools.Empty();
+}
+
+bool AML_BoardSpawner::CanDeferCollision() const
+{
+	const UWorld* World = GetWorld();
+	return (bDeferTileCollision || BoardCollision) && World && World->IsGameWorld() && !IsActorBeingDestroyed();
+}
+
+void AML_BoardSpawner::RequestCollisionFlush()
+{
+	if (GetWorldTimerManager().TimerExists(CollisionFlushTimerHandle)) return;
+
+	CollisionFlushTimerHandle = GetWorldTimerManager().SetTimerForNextTick(this, &AML_BoardSpawner::FlushTileCollision);
+}
+
+void AML_BoardSpawner::SetVisualCollision(AML_TileBase* Visual, const bool bEnable)
+{
+	if (!CanDeferCollision())
+	{
+		Visual->SetActorEnableCollision(bEnable);
+		return;
+	}
+
+	// Released then acquired again in the same frame: no physics update at all
+	PendingVisualCollision.Add(Visual, bEnable);
+	RequestCollisionFlush();
+}
+
+bool AML_BoardSpawner::DeferTileCollision(const AML_Tile* Tile)
+{
+	const int32 Index = GetTileIndex(Tile);
+	if (Index == INDEX_NONE || !CanDeferCollision()) return false;
+
+	if (DirtyCollisionTiles.Num() < SpawnedTiles.Num())
+		DirtyCollisionTiles.SetNum(SpawnedTiles.Num(), false);
+
+	DirtyCollisionTiles[Index] = true;
+	RequestCollisionFlush();
+	return true;
+}
+
+void AML_BoardSpawner::FlushTileCollision()
+{
+	GetWorldTimerManager().ClearTimer(CollisionFlushTimerHandle);
+
+	// The tiles read their current blocked state, an index reused by a rebuilt layout only costs a redundant check
+	const bool bUpdateBoardCollision = BlockedCollision && BlockedCollision->GetNumTiles() == SpawnedTiles.Num();
+	for (TConstSetBitIterator<> It(DirtyCollisionTiles); It; ++It)
+	{
+		const AML_Tile* Tile = GetTileByIndex(It.GetIndex());
+		if (!Tile) continue;
+
+		if (bUpdateBoardCollision)
+			BlockedCollision->SetTileEnabled(It.GetIndex(), Tile->IsBlocked());
 		else
+			Tile->ApplyBlockedCollision();
+	}
+	DirtyCollisionTiles.Init(false, DirtyCollisionTiles.Num());
+
+	if (bUpdateBoardCollision)
+		BlockedCollision->CommitChanges();
+
+	for (const TPair<TWeakObjectPtr<AML_TileBase>, bool>& Pair : PendingVisualCollision)
+	{
+		AML_TileBase* Visual = Pair.Key.Get();
+		if (IsValid(Visual) && Visual->GetActorEnableCollision() != Pair.Value)
+			Visual->SetActorEnableCollision(Pair.Value);
+	}
+	PendingVisualCollision.Reset();
+}
+
+UML_BoardCollisionComponent* AML_BoardSpawner::CreateBoardCollisionComponent(const bool bPawnOnly)
+{
+	UML_BoardCollisionComponent* Collision = NewObject<UML_BoardCollisionComponent>(this, NAME_None, RF_Transient);
+
+	// Blocked tiles stop the character only: cursor and camera traces go through them to the floor
+	if (bPawnOnly)
+	{
+		Collision->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+		Collision->SetCollisionResponseToAllChannels(ECR_Ignore);
+		Collision->SetCollisionResponseToChannel(ECC_Pawn, ECR_Block);
+	}
+
+	if (USceneComponent* Root = GetRootComponent())
+		Collision->SetupAttachment(Root);
+	else
+		SetRootComponent(Collision);
+
+	Collision->RegisterComponent();
+	AddInstanceComponent(Collision);
+	return Collision;
+}
+
+void AML_BoardSpawner::RebuildBoardCollision()
+{
+	const UWorld* World = GetWorld();
+	if (!bUseBoardCollision || !World || !World->IsGameWorld()) return;
+
+	if (!BoardCollision) BoardCollision = CreateBoardCollisionComponent(false);
+	if (!BlockedCollision) BlockedCollision = CreateBoardCollisionComponent(true);
+
+	const bool bFlatTop = Orientation == EML_HexOrientation::FlatTop;
+	const float FloorBottom = BoardCollisionFloorHeight - BoardCollisionFloorThickness;
+
+	BoardCollision->SetWorldLocationAndRotation(GetActorLocation(), FRotator::ZeroRotator);
+	BoardCollision->PrismRadius = TileSize;
+	BoardCollision->bFlatTop = bFlatTop;
+	BoardCollision->PrismBottom = FloorBottom;
+	BoardCollision->PrismTop = BoardCollisionFloorHeight;
+
+	BlockedCollision->SetWorldLocationAndRotation(GetActorLocation(), FRotator::ZeroRotator);
+	BlockedCollision->PrismRadius = TileSize * BlockedCollisionScale;
+	BlockedCollision->bFlatTop = bFlatTop;
+	BlockedCollision->PrismBottom = FloorBottom;
+	BlockedCollision->PrismTop = BoardCollisionFloorHeight + BlockedCollisionHeight;
+
+	TArray<FVector> TileCenters;
+	TileCenters.Reserve(Layout->Num());
+	TBitArray<> BlockedTiles(false, Layout->Num());
+
+	for (int32 Index = 0; Index < Layout->Num(); ++Index)
+	{
+		const FIntPoint& Axial = Layout->GetAxial(Index);
+		TileCenters.Add(AxialToWorld(Axial.X, Axial.Y) - GetActorLocation());
+
+		if (AML_Tile* Tile = GetTileByIndex(Index))
 		{
-			Neighbors.Add(nullptr);
+			Tile->SetUsesBoardCollision(true);
+			BlockedTiles[Index] = Tile->IsBlocked();
 		}
 	}
 
+	// The floor body stands in for the GroundBase of the pooled visuals too
+	for (const TPair<TObjectPtr<AML_Tile>, TObjectPtr<AML_TileBase>>& Pair : TileVisuals)
+	{
+		if (IsValid(Pair.Value)) SetVisualCollision(Pair.Value, false);
+	}
+
+	// The new bodies already have every blocked tile
+	DirtyCollisionTiles.Init(false, SpawnedTiles.Num());
+	BoardCollision->Build(TileCenters, TBitArray<>(true, TileCenters.Num()));
+	BlockedCollision->Build(TileCenters, BlockedTiles);
+}
+
+void AML_BoardSpawner::SyncTileState(const AML_Tile* Tile)
+{
+	const int32 Index = GetTileIndex(Tile);
+	if (!BoardState.IsValidIndex(Index)) return;
+
+	BoardState.SetType(Index, Tile->GetCurrentType());
+	BoardState.SetHasCollectible(Index, Tile->HasCollectible());
+	BoardState.SetConsumedGrass(Index, Tile->HasConsumedGrass());
+}
+
+int32 AML_BoardSpawner::GetTileIndex(const AML_Tile* Tile) const
+{
+	if (!Tile) return INDEX_NONE;
+
+	// Fast path: the tile knows its own index
+	const int32 CachedIndex = Tile->GetBoardIndex();
+	if (SpawnedTiles.IsValidIndex(CachedIndex) && SpawnedTiles[CachedIndex] == Tile) return CachedIndex;
+
+	const int32 Index = Layout->IndexOf(Tile->GetAxialCoord());
+	if (!SpawnedTiles.IsValidIndex(Index) || SpawnedTiles[Index] != Tile) return INDEX_NONE;
+
+	return Index;
+}
+
+AML_Tile* AML_BoardSpawner::GetTileAt(const FIntPoint& Axial) const
+{
+	return GetTileByIndex(Layout->IndexOf(Axial));
+}
+
+AML_Tile* AML_BoardSpawner::GetTileAtLocation(const FVector& WorldLocation) const
+{
+	return GetTileAt(WorldToAxial(WorldLocation));
+}
+
+TArray<AML_Tile*> AML_BoardSpawner::GetNeighbors(AML_Tile* CenterTile)
+{
+	const int32 CenterIndex = GetTileIndex(CenterTile);
+	if (CenterIndex == INDEX_NONE) return TArray<AML_Tile*>();
+
+	TArray<AML_Tile*> Neighbors;
+	Neighbors.Reserve(FML_BoardLayout::NumNeighbors);
+
+	for (const int32 NeighborIndex : Layout->GetNeighborIndices(CenterIndex))
+	{
+		Neighbors.Add(GetTileByIndex(NeighborIndex));
+	}
+
 	return Neighbors;
 }
 
 TMap<FIntPoint, AML_Tile*> AML_BoardSpawner::GetGridMap() const
 {
 	TMap<FIntPoint, AML_Tile*> Result;
-	Result.Reserve(GridMap.Num());
-	for (const TPair<FIntPoint, TObjectPtr<AML_Tile>>& Pair : GridMap)
+	Result.Reserve(SpawnedTiles.Num());
+	for (int32 Index = 0; Index < SpawnedTiles.Num(); ++Index)
 	{
-		Result.Add(Pair.Key, Pair.Value.Get());
+		Result.Add(Layout->GetAxial(Index), SpawnedTiles[Index].Get());
 	}
 	return Result;
 }
@@ -239,10 +847,10 @@ TMap<FIntPoint, AML_Tile*> AML_BoardSpawner::GetGridMap() const
 TArray<AML_Tile*> AML_BoardSpawner::GetGridTiles()
 {
 	TArray<AML_Tile*> Result;
-	Result.Reserve(GridMap.Num());
-	for (const TPair<FIntPoint, TObjectPtr<AML_Tile>>& Pair : GridMap)
+	Result.Reserve(SpawnedTiles.Num());
+	for (const TObjectPtr<AML_Tile>& Tile : SpawnedTiles)
 	{
-		Result.Add(Pair.Value.Get());
+		Result.Add(Tile.Get());
 	}
 	return Result;
 }
@@ -350,11 +958,11 @@ void AML_BoardSpawner::SpawnHexagonRadius()
 
 			SpawnedTiles.Add(Tile);
 			Tile->AttachToActor(this, FAttachmentTransformRules::KeepWorldTransform);
-			const FIntPoint Axial(Q, R);
-			Tile->SetAxialCoord(Axial);
-			GridMap.Add(Axial, Tile);
+			Tile->SetAxialCoord(FIntPoint(Q, R));
 		}
 	}
+
+	BuildBoardLayout();
 }
 
 FIntPoint AML_BoardSpawner::OffsetToAxial(int32 Col, int32 Row) const
@@ -417,9 +1025,9 @@ void AML_BoardSpawner::SpawnRectangleWH()
 
 			SpawnedTiles.Add(Tile);
 			Tile->AttachToActor(this, FAttachmentTransformRules::KeepWorldTransform);
-			const FIntPoint AxialQR(Q, R);
-			Tile->SetAxialCoord(AxialQR);
-			GridMap.Add(AxialQR, Tile);
+			Tile->SetAxialCoord(FIntPoint(Q, R));
 		}
 	}
+
+	BuildBoardLayout();
 }
@@ -3,6 +3,8 @@
 
 #include "Tiles/ML_Tile.h"
 
+#include "Data Asset/ML_BiomeTileSet.h"
+#include "Subsystem/ML_BoardRegistrySubsystem.h"
 #include "Tiles/ML_TileBase.h"
 #include "Tiles/TileBase/ML_TileDirt.h"
 #include "Tiles/TileBase/ML_TileGrass.h"
@@ -41,17 +43,160 @@ AML_Tile::AML_Tile()
 	HexagonCollision->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 }
 
+void AML_Tile::PostRegisterAllComponents()
+{
+	Super::PostRegisterAllComponents();
+
+	UWorld* World = GetWorld();
+	UML_BoardRegistrySubsystem* Registry = World ? World->GetSubsystem<UML_BoardRegistrySubsystem>() : nullptr;
+	if (Registry) Registry->RegisterTile(this, GetBoardSpawnerFromTile());
+}
+
+void AML_Tile::PostUnregisterAllComponents()
+{
+	UWorld* World = GetWorld();
+	UML_BoardRegistrySubsystem* Registry = World ? World->GetSubsystem<UML_BoardRegistrySubsystem>() : nullptr;
+	if (Registry) Registry->UnregisterTile(this);
+
+	Super::PostUnregisterAllComponents();
+}
+
 void AML_Tile::SetBlocked(bool bNewBlocked)
 {
 	bBlocked = bNewBlocked;
 
+	// Applied with the other tiles changed this frame
+	AML_BoardSpawner* Board = GetBoardSpawnerFromTile();
+	if (Board && Board->DeferTileCollision(this)) return;
+
+	ApplyBlockedCollision();
+}
+
+void AML_Tile::ApplyBlockedCollision() const
+{
 	if (!HexagonCollision) return;
 
-	HexagonCollision->SetCollisionEnabled(
-		bBlocked
-		? ECollisionEnabled::QueryOnly
-		: ECollisionEnabled::NoCollision
-	);
+	const ECollisionEnabled::Type Collision = bBlocked && !bUsesBoardCollision ? ECollisionEnabled::QueryOnly : ECollisionEnabled::NoCollision;
+	if (HexagonCollision->GetCollisionEnabled() != Collision)
+		HexagonCollision->SetCollisionEnabled(Collision);
+}
+
+void AML_Tile::SetUsesBoardCollision(const bool bNewValue)
+{
+	if (bUsesBoardCollision == bNewValue) return;
+
+	bUsesBoardCollision = bNewValue;
+
+	if (HighlightTileMesh)
+		HighlightTileMesh->SetCollisionEnabled(bUsesBoardCollision ? ECollisionEnabled::NoCollision : ECollisionEnabled::QueryAndPhysics);
+
+	// The GroundBase of the visual would be one more body per tile, in front of the board floor for cursor traces
+	if (AActor* ChildActor = TileChildActor ? TileChildActor->GetChildActor() : nullptr)
+		ChildActor->SetActorEnableCollision(!bUsesBoardCollision);
+
+	ApplyBlockedCollision();
+}
+
+AML_Tile* AML_Tile::FromHitResult(const FHitResult& Hit)
+{
+	AActor* HitActor = Hit.GetActor();
+	if (!HitActor) return nullptr;
+
+	if (AML_Tile* Tile = Cast<AML_Tile>(HitActor))
+		return Tile;
+
+	// Board collision body (AML_BoardSpawner::bUseBoardCollision)
+	if (const AML_BoardSpawner* Board = Cast<AML_BoardSpawner>(HitActor))
+		return Board->GetTileAtLocation(Hit.ImpactPoint);
+
+	if (const UPrimitiveComponent* Comp = Hit.GetComponent())
+		if (AML_Tile* OuterTile = Comp->GetTypedOuter<AML_Tile>())
+			return OuterTile;
+
+	// Child actor visual, or pooled visual owned by its tile
+	if (AML_Tile* ParentTile = Cast<AML_Tile>(HitActor->GetParentActor()))
+		return ParentTile;
+
+	return Cast<AML_Tile>(HitActor->GetOwner());
+}
+
+void AML_Tile::SyncBoardState() const
+{
+	if (AML_BoardSpawner* Board = GetBoardSpawnerFromTile())
+	{
+		Board->SyncTileState(this);
+	}
+}
+
+void AML_Tile::SetCurrentType(const EML_TileType NewType)
+{
+	CurrentType = NewType;
+	SyncBoardState();
+}
+
+void AML_Tile::SetHasCollectible(const bool bNewValue)
+{
+	bHasCollectible = bNewValue;
+	SyncBoardState();
+}
+
+void AML_Tile::SetConsumedGrass(const bool bNewValue)
+{
+	bConsumedGrass = bNewValue;
+	SyncBoardState();
+}
+
+void AML_Tile::UpdateVisual(const TSubclassOf<AML_TileBase> NewClass)
+{
+	AML_BoardSpawner* Board = GetBoardSpawnerFromTile();
+	if (Board && Board->UpdateTileVisual(this, NewClass))
+	{
+		if (TileChildActor->GetChildActorClass()) TileChildActor->SetChildActorClass(nullptr);
+		return;
+	}
+
+	SetChildActorVisual(NewClass);
+}
+
+void AML_Tile::SetChildActorVisual(const TSubclassOf<AML_TileBase> NewClass)
+{
+	TileChildActor->SetChildActorClass(NewClass);
+
+	if (AActor* ChildActor = TileChildActor->GetChildActor())
+		ChildActor->SetActorEnableCollision(!bUsesBoardCollision);
+}
+
+TSubclassOf<AML_TileBase> AML_Tile::GetClassFieldForType(const EML_TileType Type) const
+{
+	switch (Type)
+	{
+		case EML_TileType::Dirt:		return DirtClass;
+		case EML_TileType::Grass:		return GrassClass;
+		case EML_TileType::Parasite:	return ParasiteClass;
+		case EML_TileType::Water:		return WaterClass;
+		case EML_TileType::Obstacle:	return ObstacleClass;
+		case EML_TileType::Tree:		return TreeClass;
+		default:						return nullptr;
+	}
+}
+
+TSubclassOf<AML_TileBase> AML_Tile::GetTypeVisualClass() const
+{
+	const AML_BoardSpawner* Board = GetBoardSpawnerFromTile();
+	const UML_BiomeTileSet* TileSet = Board ? Board->GetBiomeTileSet() : nullptr;
+
+	// The biome has no obstacle or tree class
+	const bool bBiomeType = CurrentType == EML_TileType::Dirt || CurrentType == EML_TileType::Grass
+		|| CurrentType == EML_TileType::Parasite || CurrentType == EML_TileType::Water;
+	const TSubclassOf<AML_TileBase> BiomeClass = TileSet && bBiomeType ? TileSet->GetClassFromTileType(CurrentType) : nullptr;
+
+	// At runtime the waves show the biome classes (UpdateClassAtRuntime), in the editor the tile classes
+	const UWorld* World = GetWorld();
+	if (BiomeClass && World && World->IsGameWorld())
+		return BiomeClass;
+
+	const TSubclassOf<AML_TileBase> FieldClass = GetClassFieldForType(CurrentType);
+	return FieldClass ? FieldClass : BiomeClass;
 }
 
 bool AML_Tile::IsTileTypeBlocking(const EML_TileType Type)
@@ -100,24 +245,15 @@ void AML_Tile::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEven
 void AML_Tile::UpdateClassInEditor(const EML_TileType NewTileType)
 {
 	CurrentType = NewTileType;
-	TSubclassOf<AML_TileBase> TileBase;
-	
-	switch (CurrentType)
-	{
-		case EML_TileType::Dirt:		TileBase = DirtClass; break;
-		case EML_TileType::Grass:		TileBase = GrassClass; break;
-		case EML_TileType::Parasite:	TileBase = ParasiteClass; break;
-		case EML_TileType::Water:		TileBase = WaterClass; break;
-		case EML_TileType::Obstacle:	TileBase = ObstacleClass; break;
-		case EML_TileType::Tree:		TileBase = TreeClass; break;
-	}
+	const TSubclassOf<AML_TileBase> TileBase = GetClassFieldForType(CurrentType);
 	
 	TileChildActor->SetChildActorClass(TileBase);
 	SetBlocked(IsTileTypeBlocking(NewTileType));
+	SyncBoardState();
 }
 #endif
 
-void AML_Tile::UpdateClassAtRuntime(const EML_TileType NewTileType, const TSubclassOf<AML_TileBase> NewClass)
+void AML_Tile::UpdateClassAtRuntime(const EML_TileType NewTileType, const TSubclassOf<AML_TileBase> NewClass, const bool bFireTileEvent)
 {
 	if (!NewClass) return;
 	
@@ -129,9 +265,12 @@ void AML_Tile::UpdateClassAtRuntime(const EML_TileType NewTileType, const TSubcl
 	// If there is a change from grass to parasite
 	bConsumedGrass = (OldType == EML_TileType::Grass && NewTileType == EML_TileType::Parasite);
 	
-	TileChildActor->SetChildActorClass(NewClass);
+	UpdateVisual(NewClass);
 	SetBlocked(IsTileTypeBlocking(NewTileType));
-	OnTileTypeChanged(OldType, NewTileType);
+	SyncBoardState();
+
+	if (bFireTileEvent)
+		OnTileTypeChanged(OldType, NewTileType);
 }
 
 void AML_Tile::UpdateClassAtRuntime_Silent(const EML_TileType NewTileType, const TSubclassOf<AML_TileBase> NewClass)
@@ -146,8 +285,9 @@ void AML_Tile::UpdateClassAtRuntime_Silent(const EML_TileType NewTileType, const
 
 	CurrentType = NewTileType;
 
-	TileChildActor->SetChildActorClass(NewClass);
+	UpdateVisual(NewClass);
 	SetBlocked(IsTileTypeBlocking(NewTileType));
+	SyncBoardState();
 
 	// NO OnTileTypeChanged(OldType, NewTileType) in silent mode
 }
@@ -3,84 +3,62 @@
 
 #include "Waves/ChildWaves/ML_WaveCollectible.h"
 
+#include "Core/ML_BoardState.h"
 #include "Core/ML_CoreData.h"
-#include "Data Asset/ML_BiomeTileSet.h"
-#include "Developer Settings/ML_MycelandDeveloperSettings.h"
-#include "Subsystem/ML_WavePropagationSubsystem.h"
-#include "Tiles/ML_Tile.h"
+#include "Core/ML_HexBFS.h"
+#include "Waves/ML_WavePipeline.h"
 
-void UML_WaveCollectible::ComputeWaveForCollectibles(AML_Tile* OriginTile, const TArray<AML_Tile*>& ParasitesThatAteGrass, TArray<FML_WaveChange>& OutChanges)
+void UML_WaveCollectible::Execute(FML_WaveContext& Context, FML_BoardChangeBuckets& OutChanges) const
 {
-    GEngine->AddOnScreenDebugMessage(-1, 10.f, FColor::Yellow, TEXT("Collectible Wave"));
-    
-    if (!OriginTile || ParasitesThatAteGrass.Num() == 0) return;
-
-    AML_BoardSpawner* Board = OriginTile->GetBoardSpawnerFromTile();
-    ensureMsgf(Board, TEXT("Board is not set!"));
-    if (!Board) return;
-
-    TSet<AML_Tile*> ParasiteSet(ParasitesThatAteGrass);
-
-    TQueue<TPair<AML_Tile*, int32>> Queue;
-    TSet<AML_Tile*> Visited;
+    ComputeCollectiblesOnState(Context.State, Context.OriginIndex, Context.ParasitesThatAteGrass, OutChanges);
+    Context.ParasitesThatAteGrass.Reset();
+}
 
-    Queue.Enqueue({ OriginTile, 0 });
-    Visited.Add(OriginTile);
+void UML_WaveCollectible::ComputeCollectiblesOnState(const FML_BoardState& State, const int32 OriginIndex, const TConstArrayView<int32> ParasitesThatAteGrass, FML_BoardChangeBuckets& OutChanges) const
+{
+    if (!State.IsValidIndex(OriginIndex) || ParasitesThatAteGrass.Num() == 0) return;
 
-    while (!Queue.IsEmpty())
+    TBitArray<> ParasiteSet(false, State.Num());
+    for (const int32 ParasiteIndex : ParasitesThatAteGrass)
     {
-        TPair<AML_Tile*, int32> Current;
-        Queue.Dequeue(Current);
+        if (State.IsValidIndex(ParasiteIndex)) ParasiteSet[ParasiteIndex] = true;
+    }
 
-        AML_Tile* Tile = Current.Key;
-        int32 Distance = Current.Value;
+    // Continue propagation everywhere (like other waves), spawn next to the parasites that have eaten
+    struct FCollectiblePolicy : FML_HexBFSPolicy
+    {
+        const FML_BoardState& State;
+        const TBitArray<>& ParasiteSet;
+        FML_BoardChangeBuckets& OutChanges;
 
-        if (!Tile) continue;
+        FCollectiblePolicy(const FML_BoardState& InState, const TBitArray<>& InParasiteSet, FML_BoardChangeBuckets& InOutChanges)
+            : State(InState), ParasiteSet(InParasiteSet), OutChanges(InOutChanges) {}
 
-        TArray<AML_Tile*> Neighbors = Board->GetNeighbors(Tile);
-        for (AML_Tile* Neighbor : Neighbors)
+        EML_HexBFSVisit OnVisit(const int32 Index, const int32 Distance)
         {
-            if (!Neighbor || Visited.Contains(Neighbor))
-                continue;
-
-            Visited.Add(Neighbor);
-
-            // Continue propagation everywhere (like other waves)
-            Queue.Enqueue({ Neighbor, Distance + 1 });
+            if (Distance == 0)
+                return EML_HexBFSVisit::Expand;
 
             // Spawn condition
-            if (!Neighbor->HasCollectible() &&
-                (Neighbor->GetCurrentType() == EML_TileType::Dirt ||
-                 Neighbor->GetCurrentType() == EML_TileType::Grass))
+            const EML_TileType Type = State.GetType(Index);
+            if (State.HasCollectible(Index) || (Type != EML_TileType::Dirt && Type != EML_TileType::Grass))
+                return EML_HexBFSVisit::Expand;
+
+            // Check if this tile is near a parasite that has eaten
+            for (const int32 CheckIndex : State.GetNeighbors(Index))
             {
-                // Check if this tile is near a parasite that has eaten
-                TArray<AML_Tile*> CheckNeighbors = Board->GetNeighbors(Neighbor);
-                for (AML_Tile* CheckTile : CheckNeighbors)
+                if (CheckIndex != INDEX_NONE && ParasiteSet[CheckIndex])
                 {
-                    if (ParasiteSet.Contains(CheckTile))
-                    {
-                        FML_WaveChange Change;
-                        Change.Neighbor = Neighbor;
-                        Change.SpawnLocation = Neighbor->GetActorLocation();
-                        Change.CollectibleClass = Board->GetBiomeTileSet()->GetCollectibleClass();
-                        Change.DistanceFromOrigin = Distance + 1;
-
-                        OutChanges.Add(Change);
-
-                        // NEW: record undo snapshot before flipping the flag
-                        if (UWorld* World = OriginTile->GetWorld())
-                        {
-                            if (UML_WavePropagationSubsystem* S = World->GetSubsystem<UML_WavePropagationSubsystem>())
-                            {
-                                S->RecordTileForUndo(Neighbor, Distance + 1);
-                            }
-                        }
-                        
-                        Neighbor->SetHasCollectible(true);
-                        break;
-                    }
+                    OutChanges.Add(FML_BoardChange::Collectible(Index, Distance));
+                    break;
                 }
             }
+            return EML_HexBFSVisit::Expand;
         }
-    }
+    };
+
+    thread_local FML_HexBFSScratch Scratch;
+
+    FCollectiblePolicy Policy(State, ParasiteSet, OutChanges);
+    FML_HexBFS::Run(State.GetLayout(), OriginIndex, Policy, Scratch);
 }
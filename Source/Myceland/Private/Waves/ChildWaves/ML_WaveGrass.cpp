@@ -3,67 +3,92 @@
 
 #include "Waves/ChildWaves/ML_WaveGrass.h"
 
-#include "Tiles/ML_BoardSpawner.h"
+#include "Core/ML_BoardState.h"
 #include "Core/ML_CoreData.h"
-#include "Tiles/ML_Tile.h"
+#include "Core/ML_HexBFS.h"
 
-void UML_WaveGrass::ExpandWaterNetwork(AML_BoardSpawner* Board, AML_Tile* FromTile, TSet<AML_Tile*>& WaterConnected)
+namespace
 {
-    TQueue<AML_Tile*> ExpansionQueue;
+    bool IsDirtLike(const FML_BoardState& State, const int32 Index)
+    {
+        return State.GetType(Index) == EML_TileType::Dirt || State.GetType(Index) == EML_TileType::Obstacle;
+    }
+
+    // WaterConnected is indexed by water component (FML_BoardState::GetWaterComponent)
+    bool TouchesWater(const FML_BoardState& State, const int32 Index, const TBitArray<>& WaterConnected)
+    {
+        for (const int32 AroundIndex : State.GetNeighbors(Index))
+        {
+            if (AroundIndex == INDEX_NONE)
+                continue;
+
+            const int32 Component = State.GetWaterComponent(AroundIndex);
+            if (Component != INDEX_NONE && WaterConnected[Component])
+                return true;
+        }
+        return false;
+    }
 
-    for (AML_Tile* Neighbor : Board->GetNeighbors(FromTile))
+    // Connects the water bodies around FromIndex
+    void ExpandWaterNetwork(const FML_BoardState& State, const int32 FromIndex, TBitArray<>& WaterConnected)
     {
-        if (Neighbor && Neighbor->GetCurrentType() == EML_TileType::Water && !WaterConnected.Contains(Neighbor))
+        for (const int32 NeighborIndex : State.GetNeighbors(FromIndex))
         {
-            WaterConnected.Add(Neighbor);
-            ExpansionQueue.Enqueue(Neighbor);
+            if (NeighborIndex == INDEX_NONE)
+                continue;
+
+            const int32 Component = State.GetWaterComponent(NeighborIndex);
+            if (Component != INDEX_NONE)
+                WaterConnected[Component] = true;
         }
     }
 
-    while (!ExpansionQueue.IsEmpty())
+    // Grass spreads on dirt-like tiles touching the water network, which grows with every new grass
+    struct FGrassSpreadPolicy : FML_HexBFSPolicy
     {
-        AML_Tile* CurrentWater;
-        ExpansionQueue.Dequeue(CurrentWater);
+        const FML_BoardState& State;
+        TBitArray<>& WaterConnected;
+        FML_BoardChangeBuckets& OutChanges;
+
+        FGrassSpreadPolicy(const FML_BoardState& InState, TBitArray<>& InWaterConnected, FML_BoardChangeBuckets& InOutChanges)
+            : State(InState), WaterConnected(InWaterConnected), OutChanges(InOutChanges) {}
+
+        bool CanEnter(const int32 FromIndex, const int32 ToIndex) const
+        {
+            return IsDirtLike(State, ToIndex) && TouchesWater(State, ToIndex, WaterConnected);
+        }
 
-        for (AML_Tile* Neighbor : Board->GetNeighbors(CurrentWater))
+        EML_HexBFSVisit OnVisit(const int32 Index, const int32 Distance)
         {
-            if (Neighbor && Neighbor->GetCurrentType() == EML_TileType::Water && !WaterConnected.Contains(Neighbor))
+            // Sources are already grass (or the planted origin)
+            if (Distance > 0 && State.GetType(Index) == EML_TileType::Dirt)
             {
-                WaterConnected.Add(Neighbor);
-                ExpansionQueue.Enqueue(Neighbor);
+                OutChanges.Add(FML_BoardChange(Index, EML_TileType::Grass, Distance));
+                ExpandWaterNetwork(State, Index, WaterConnected);
             }
+            return EML_HexBFSVisit::Expand;
         }
-    }
+    };
 }
 
-bool UML_WaveGrass::IsDirtLike(const AML_Tile* Tile)
+void UML_WaveGrass::ComputeWaveOnState(const FML_BoardState& State, const int32 OriginIndex, FML_BoardChangeBuckets& OutChanges) const
 {
-    return Tile->GetCurrentType() == EML_TileType::Dirt || Tile->GetCurrentType() == EML_TileType::Obstacle;
-}
+    if (!State.IsValidIndex(OriginIndex)) return;
 
-void UML_WaveGrass::ComputeWave(AML_Tile* OriginTile, TArray<FML_WaveChange>& OutChanges)
-{
-    GEngine->AddOnScreenDebugMessage(-1, 10.f, FColor::Green, TEXT("Grass Wave"));
-    
-     if (!OriginTile) return;
+    thread_local FML_HexBFSScratch Scratch;
 
-    AML_BoardSpawner* Board = OriginTile->GetBoardSpawnerFromTile();
-    if (!Board) return;
-
-    TSet<AML_Tile*> Scheduled;
-    TSet<AML_Tile*> WaterConnected;
-    TArray<AML_Tile*> GrassSources;
+    TBitArray<> WaterConnected(false, State.Num());
+    TArray<int32> GrassSources;
 
     // -------------------------------------------------
     // CASE 1: FIRST WAVE (Origin = Dirt)
     // -------------------------------------------------
-    if (OriginTile->GetCurrentType() == EML_TileType::Dirt)
+    if (State.GetType(OriginIndex) == EML_TileType::Dirt)
     {
-        OutChanges.Add(FML_WaveChange(OriginTile, EML_TileType::Grass, 0));
-        Scheduled.Add(OriginTile);
-        GrassSources.Add(OriginTile);
+        OutChanges.Add(FML_BoardChange(OriginIndex, EML_TileType::Grass, 0));
+        GrassSources.Add(OriginIndex);
 
-        ExpandWaterNetwork(Board, OriginTile, WaterConnected);
+        ExpandWaterNetwork(State, OriginIndex, WaterConnected);
     }
     else
     {
@@ -72,15 +97,12 @@ void UML_WaveGrass::ComputeWave(AML_Tile* OriginTile, TArray<FML_WaveChange>& Ou
         // -------------------------------------------------
 
         // We take all existing Grasses
-        for (AML_Tile* Tile : Board->GetGridTiles())
+        for (int32 Index = 0; Index < State.Num(); ++Index)
         {
-            if (!Tile) continue;
-
-            if (Tile->GetCurrentType() == EML_TileType::Grass)
+            if (State.GetType(Index) == EML_TileType::Grass)
             {
-                GrassSources.Add(Tile);
-                ExpandWaterNetwork(Board, Tile, WaterConnected);
-                Scheduled.Add(Tile);
+                GrassSources.Add(Index);
+                ExpandWaterNetwork(State, Index, WaterConnected);
             }
         }
 
@@ -92,80 +114,7 @@ void UML_WaveGrass::ComputeWave(AML_Tile* OriginTile, TArray<FML_WaveChange>& Ou
     // COMPLETE BFS PROPAGATION (STEP-BY-STEP via Distance)
     // -------------------------------------------------
 
-    TQueue<TPair<AML_Tile*, int32>> PropagationQueue;
-
-    // Initialization
-    for (AML_Tile* Source : GrassSources)
-    {
-        for (AML_Tile* Neighbor : Board->GetNeighbors(Source))
-        {
-            if (!Neighbor || Scheduled.Contains(Neighbor))
-                continue;
-
-            if (!IsDirtLike(Neighbor))
-                continue;
-
-            bool bTouchesWater = false;
-            for (AML_Tile* Around : Board->GetNeighbors(Neighbor))
-            {
-                if (Around && WaterConnected.Contains(Around))
-                {
-                    bTouchesWater = true;
-                    break;
-                }
-            }
-
-            if (bTouchesWater)
-            {
-                PropagationQueue.Enqueue({ Neighbor, 1 });
-                Scheduled.Add(Neighbor);
-            }
-        }
-    }
-
-    while (!PropagationQueue.IsEmpty())
-    {
-        TPair<AML_Tile*, int32> Current;
-        PropagationQueue.Dequeue(Current);
-
-        AML_Tile* CurrentTile = Current.Key;
-        int32 StepDistance = Current.Value;
-
-        if (CurrentTile->GetCurrentType() == EML_TileType::Dirt)
-        {
-            OutChanges.Add(FML_WaveChange(CurrentTile, EML_TileType::Grass, StepDistance));
-            ExpandWaterNetwork(Board, CurrentTile, WaterConnected);
-        }
-
-        for (AML_Tile* Neighbor : Board->GetNeighbors(CurrentTile))
-        {
-            if (!Neighbor || Scheduled.Contains(Neighbor))
-                continue;
-
-            if (!IsDirtLike(Neighbor))
-                continue;
-
-            bool bTouchesWater = false;
-            for (AML_Tile* Around : Board->GetNeighbors(Neighbor))
-            {
-                if (Around && WaterConnected.Contains(Around))
-                {
-                    bTouchesWater = true;
-                    break;
-                }
-            }
-
-            if (bTouchesWater)
-            {
-                PropagationQueue.Enqueue({ Neighbor, StepDistance + 1 });
-                Scheduled.Add(Neighbor);
-            }
-        }
-    }
-
-    // We sort by distance to ensure the correct order
-    OutChanges.Sort([](const FML_WaveChange& A, const FML_WaveChange& B)
-    {
-        return A.DistanceFromOrigin < B.DistanceFromOrigin;
-    });
+    // Changes land in their distance bucket in BFS order
+    FGrassSpreadPolicy Policy(State, WaterConnected, OutChanges);
+    FML_HexBFS::Run(State.GetLayout(), GrassSources, Policy, Scratch);
 }
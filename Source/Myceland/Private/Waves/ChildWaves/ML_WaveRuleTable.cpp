@@ -0,0 +1,28 @@
+﻿// Copyright Myceland Team, All Rights Reserved.
+
+
+#include "Waves/ChildWaves/ML_WaveRuleTable.h"
+
+#include "Core/ML_BoardState.h"
+#include "Data Asset/ML_WaveRuleSet.h"
+#include "Waves/ML_WavePipeline.h"
+
+void UML_WaveRuleTable::ComputeWaveOnState(const FML_BoardState& State, const int32 OriginIndex, FML_BoardChangeBuckets& OutChanges) const
+{
+	if (const TSharedPtr<const FML_CompiledWaveRules, ESPMode::ThreadSafe> Rules = GetCompiledRules())
+		Rules->Execute(State, OutChanges);
+}
+
+void UML_WaveRuleTable::Execute(FML_WaveContext& Context, FML_BoardChangeBuckets& OutChanges) const
+{
+	// Snapshot pipeline: never read the rule set from here, the editor may recompile it on the game thread
+	if (Context.Rules)
+		Context.Rules->Execute(Context.State, OutChanges);
+	else
+		Super::Execute(Context, OutChanges);
+}
+
+TSharedPtr<const FML_CompiledWaveRules, ESPMode::ThreadSafe> UML_WaveRuleTable::GetCompiledRules() const
+{
+	return RuleSet ? RuleSet->GetCompiledRules() : nullptr;
+}
@@ -2,3 +2,14 @@
 
 
 #include "Waves/ML_PropagationWaves.h"
+
+#include "Core/ML_BoardState.h"
+#include "Waves/ML_WavePipeline.h"
+
+void UML_PropagationWaves::Execute(FML_WaveContext& Context, FML_BoardChangeBuckets& OutChanges) const
+{
+	if (Context.ChangedTiles.IsSet())
+		ComputeWaveOnChangedState(Context.State, Context.OriginIndex, Context.ChangedTiles.GetValue(), OutChanges);
+	else
+		ComputeWaveOnState(Context.State, Context.OriginIndex, OutChanges);
+}
@@ -0,0 +1,71 @@
+﻿// Copyright Myceland Team, All Rights Reserved.
+
+
+#include "Waves/ML_WavePipeline.h"
+
+#include "Core/ML_WaveRuleEngine.h"
+#include "Waves/ML_PropagationWaves.h"
+
+FML_WavePipeline FML_WavePipeline::Compile(const TConstArrayView<TSubclassOf<UML_PropagationWaves>> WavesPriority)
+{
+	FML_WavePipeline Pipeline;
+	Pipeline.Stages.Reserve(WavesPriority.Num());
+
+	for (int32 PriorityIndex = 0; PriorityIndex < WavesPriority.Num(); ++PriorityIndex)
+	{
+		const TSubclassOf<UML_PropagationWaves>& WaveClass = WavesPriority[PriorityIndex];
+		if (!WaveClass) continue;
+
+		FML_WaveStage& Stage = Pipeline.Stages.AddDefaulted_GetRef();
+		Stage.Wave = WaveClass->GetDefaultObject<UML_PropagationWaves>();
+		Stage.PriorityIndex = PriorityIndex;
+	}
+
+	return Pipeline;
+}
+
+FML_WavePipeline FML_WavePipeline::Snapshot() const
+{
+	FML_WavePipeline Pipeline = *this;
+
+	for (FML_WaveStage& Stage : Pipeline.Stages)
+	{
+		if (const UML_PropagationWaves* Wave = Stage.Wave.Get())
+			Stage.Rules = Wave->GetCompiledRules();
+	}
+
+	return Pipeline;
+}
+
+uint32 FML_WavePipeline::GetRulesVersion() const
+{
+	uint32 Version = 0;
+	for (const FML_WaveStage& Stage : Stages)
+	{
+		const UML_PropagationWaves* Wave = Stage.Wave.Get();
+		const TSharedPtr<const FML_CompiledWaveRules, ESPMode::ThreadSafe> Rules = Wave ? Wave->GetCompiledRules() : nullptr;
+		if (Rules) Version = HashCombineFast(Version, Rules->GetVersion());
+	}
+	return Version;
+}
+
+bool FML_WavePipeline::IsValid() const
+{
+	for (const FML_WaveStage& Stage : Stages)
+	{
+		if (!Stage.Wave.IsValid()) return false;
+	}
+	return true;
+}
+
+bool FML_WavePipeline::UsesWave(const UObject* Object) const
+{
+	if (!Object) return false;
+
+	for (const FML_WaveStage& Stage : Stages)
+	{
+		const UML_PropagationWaves* Wave = Stage.Wave.Get();
+		if (Wave && (Wave == Object || Wave->GetClass() == Object)) return true;
+	}
+	return false;
+}
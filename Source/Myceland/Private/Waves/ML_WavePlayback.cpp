@@ -0,0 +1,46 @@
+﻿// Copyright Myceland Team, All Rights Reserved.
+
+
+#include "Waves/ML_WavePlayback.h"
+
+void FML_WavePlaybackScheduler::Begin(TArray<float>&& InDelays)
+{
+	Delays = MoveTemp(InDelays);
+	NextEntry = 0;
+	Clock = 0.f;
+	bFlushAll = false;
+}
+
+void FML_WavePlaybackScheduler::Stop()
+{
+	Delays.Reset();
+	NextEntry = 0;
+	Clock = 0.f;
+	bFlushAll = false;
+}
+
+int32 FML_WavePlaybackScheduler::Advance(const float DeltaTime, int32& OutFirstEntry)
+{
+	OutFirstEntry = NextEntry;
+	if (!IsPlaying()) return 0;
+
+	if (bFlushAll)
+	{
+		NextEntry = Delays.Num();
+		Clock = 0.f;
+		bFlushAll = false;
+		return NextEntry - OutFirstEntry;
+	}
+
+	const float Scale = FMath::Max(MinTimeScale, TimeScale) * (bFastForward ? FMath::Max(1.f, FastForwardScale) : 1.f);
+	Clock += DeltaTime * Scale;
+
+	// Leftover time carries over to the next entry, the pace does not depend on the frame rate
+	while (IsPlaying() && Clock >= Delays[NextEntry])
+	{
+		Clock -= Delays[NextEntry];
+		++NextEntry;
+	}
+
+	return NextEntry - OutFirstEntry;
+}
@@ -0,0 +1,131 @@
+﻿// Copyright Myceland Team, All Rights Reserved.
+
+
+#include "Waves/ML_WaveResolver.h"
+
+#include "Waves/ML_PropagationWaves.h"
+#include "Waves/ML_WavePipeline.h"
+#include "Core/ML_Zobrist.h"
+
+void FML_WaveResolver::Resolve(const FML_BoardState& InitialState, FML_WaveResolveParams& Params, FML_WaveTimeline& OutTimeline)
+{
+	OutTimeline = FML_WaveTimeline();
+	OutTimeline.FinalState = InitialState;
+
+	const TConstArrayView<FML_WaveStage> Stages = Params.Pipeline ? Params.Pipeline->GetStages() : TConstArrayView<FML_WaveStage>();
+	OutTimeline.RanWaves.Init(false, Stages.Num());
+	Params.WaveSerials.SetNumZeroed(Stages.Num());
+
+	FML_BoardState& State = OutTimeline.FinalState;
+	if (!State.IsValidIndex(Params.OriginIndex)) return;
+
+	TArray<int32> ParasitesThatAteGrass;
+	FML_BoardChangeBuckets WaveChanges;
+
+	// Cycle state hash -> cycle that ended on it
+	TMap<uint64, int32> CycleEndHashes;
+
+	for (int32 Cycle = 0; ; ++Cycle)
+	{
+		if (Cycle == Params.MaxCycles)
+		{
+			OutTimeline.bReachedCycleLimit = true;
+			return;
+		}
+
+		bool bCycleHasChanges = false;
+
+		for (int32 StageIndex = 0; StageIndex < Stages.Num(); ++StageIndex)
+		{
+			if (Params.CancelFlag && Params.CancelFlag->load(std::memory_order_relaxed))
+			{
+				OutTimeline.bCancelled = true;
+				return;
+			}
+
+			const FML_WaveStage& Stage = Stages[StageIndex];
+			const UML_PropagationWaves* Wave = Stage.Wave.Get();
+			if (!Wave) continue;
+
+			WaveChanges.Reset();
+
+			FML_WaveContext Context(State, Params.OriginIndex, ParasitesThatAteGrass);
+			Context.Rules = Stage.Rules.Get();
+
+			uint32& WaveSerial = Params.WaveSerials[StageIndex];
+			TConstArrayView<int32> ChangedTiles;
+			if (WaveSerial != 0 && State.GetChangesSince(WaveSerial, ChangedTiles))
+				Context.ChangedTiles = ChangedTiles;
+
+			Wave->Execute(Context, WaveChanges);
+
+			WaveSerial = State.GetChangeSerial();
+			OutTimeline.RanWaves[StageIndex] = true;
+
+			// No changes in this wave → STOP immediately
+			if (WaveChanges.IsEmpty()) return;
+
+			// One step per non-empty distance bucket, already in playback order
+			bool bFirstStep = true;
+			for (int32 Distance = 0; Distance < WaveChanges.GetNumBuckets(); ++Distance)
+			{
+				const TConstArrayView<FML_BoardChange> Bucket = WaveChanges.GetBucket(Distance);
+				if (Bucket.IsEmpty()) continue;
+
+				FML_WaveTimelineStep& Step = OutTimeline.Steps.AddDefaulted_GetRef();
+				Step.PriorityIndex = Stage.PriorityIndex;
+				Step.DistanceFromOrigin = Distance;
+				Step.bStartsWave = bFirstStep;
+				Step.FirstChange = OutTimeline.Changes.Num();
+				Step.NumChanges = Bucket.Num();
+				OutTimeline.Changes.Append(Bucket);
+				bFirstStep = false;
+
+				for (const FML_BoardChange& Change : Bucket)
+				{
+					const bool bChanged = State.ApplyChange(Change);
+					if (Change.bSpawnCollectible)
+					{
+						bCycleHasChanges = true;
+						continue;
+					}
+
+					if (bChanged) bCycleHasChanges = true;
+
+					// Parasite bookkeeping
+					if (State.GetType(Change.TileIndex) == EML_TileType::Parasite && State.HasConsumedGrass(Change.TileIndex))
+					{
+						ParasitesThatAteGrass.Add(Change.TileIndex);
+						State.SetConsumedGrass(Change.TileIndex, false);
+					}
+
+					// Same rule as UML_WinLoseSubsystem::CheckPlayerKilled
+					const EML_TileType NewType = State.GetType(Change.TileIndex);
+					if (Change.TileIndex == Params.PlayerIndex && (NewType == EML_TileType::Water || NewType == EML_TileType::Parasite))
+					{
+						OutTimeline.bPlayerKilled = true;
+					}
+				}
+			}
+		}
+
+		// Restart cycle only if changes occurred (propagation chain reaction)
+		if (!bCycleHasChanges) return;
+
+		// The next cycle depends on the board and on the parasites still waiting for the collectible wave
+		uint64 CycleHash = State.GetHash();
+		for (const int32 ParasiteIndex : ParasitesThatAteGrass)
+		{
+			CycleHash ^= FML_Zobrist::PendingParasiteKey(ParasiteIndex);
+		}
+
+		if (const int32* SeenCycle = CycleEndHashes.Find(CycleHash))
+		{
+			OutTimeline.bDetectedLoop = true;
+			OutTimeline.LoopStartCycle = *SeenCycle;
+			OutTimeline.LoopEndCycle = Cycle;
+			return;
+		}
+		CycleEndHashes.Add(CycleHash, Cycle);
+	}
+}
@@ -20,6 +20,10 @@ class MYCELAND_API AML_Collectible : public AActor
 private:
 	UPROPERTY()
 	AML_Tile* OwningTile = nullptr;
+	
+	// Pool bookkeeping (UML_CollectiblePoolSubsystem)
+	bool bInPool = false;
+	int32 PoolGeneration = 0;
 
 protected:
 	virtual void BeginPlay() override;
@@ -37,7 +41,7 @@ public:
 	AML_Collectible();
 	virtual void Tick(float DeltaTime) override;
 	
-	UFUNCTION(BlueprintCallable, Category="Myceland Collectible", meta=(Tooltip="Will clear the bHasCollectible from the tile it was on, and then destroy this actor !"))
+	UFUNCTION(BlueprintCallable, Category="Myceland Collectible", meta=(Tooltip="Will clear the bHasCollectible from the tile it was on, and then return this actor to the collectible pool !"))
 	void AddEnergy(AML_PlayerController* MycelandController, AML_PlayerCharacter* MycelandCharacter);
 	
 	// UFUNCTION(BlueprintPure, Category="Myceland Collectible")
@@ -51,4 +55,16 @@ public:
 
 	void InitOwningAxial(const FIntPoint& InAxial) { OwningAxial = InAxial; }
 	const FIntPoint& GetOwningAxial() const { return OwningAxial; }
+	
+	// Pool support, only called by UML_CollectiblePoolSubsystem
+	void ActivateFromPool(const FVector& Location);
+	void DeactivateToPool();
+	bool IsInPool() const { return bInPool; }
+	
+	// Incremented on every activation, tells apart two uses of the same actor
+	int32 GetPoolGeneration() const { return PoolGeneration; }
+	
+	// Reset any Blueprint state here, the actor may have been used before
+	UFUNCTION(BlueprintImplementableEvent, Category="Myceland Collectible")
+	void OnActivatedFromPool();
 };
@@ -0,0 +1,67 @@
+﻿// Copyright Myceland Team, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/ML_BoardLayout.h"
+#include "Core/ML_CoreData.h"
+
+struct FML_BoardChangeBuckets;
+
+/**
+ * One bitset per tile type over the padded axial bounding box of a board.
+ * Bit of (q, r) = LocalR * Stride + LocalQ with Stride = Width + 1: the extra column is never part of the board,
+ * so the 6 hex neighbors are plain shifts (+-1, +-Stride, +-(Stride - 1)) masked by the board.
+ * One propagation step then handles 64 tiles per word operation.
+ */
+struct MYCELAND_API FML_BoardBitboard
+{
+	using FWord = uint64;
+	static constexpr int32 BitsPerWord = 64;
+	static constexpr int32 NumTileTypes = static_cast<int32>(EML_TileType::Tree) + 1;
+
+	// Every tile starts as Dirt
+	void Init(const TSharedRef<const FML_BoardLayout>& InLayout);
+
+	bool IsValid() const { return Layout.IsValid(); }
+	int32 GetNumWords() const { return NumWords; }
+
+	void SetType(const int32 Index, const EML_TileType OldType, const EML_TileType NewType);
+
+	TConstArrayView<FWord> GetBoardMask() const { return BoardMask; }
+	TConstArrayView<FWord> GetTypeMask(const EML_TileType Type) const { return MakeArrayView(TypeMasks.GetData() + static_cast<int32>(Type) * NumWords, NumWords); }
+
+	// Index <-> bit conversions, IndexOfBit returns INDEX_NONE for padding and holes
+	int32 BitOf(const int32 Index) const;
+	int32 IndexOfBit(const int32 Bit) const;
+
+	// Out = every board tile adjacent to a tile of In
+	void Dilate(TConstArrayView<FWord> In, TArrayView<FWord> Out) const;
+
+	// Grows every tile of SourceType through the connected tiles of IntoType, one distance layer per step.
+	// Every reached tile is reported as turning into SourceType at its BFS distance (Parasite/Water waves).
+	void FloodFill(EML_TileType SourceType, EML_TileType IntoType, FML_BoardChangeBuckets& OutChanges) const;
+	
+	// Same, growing only from the tiles of SourceType inside SeedMask
+	void FloodFill(EML_TileType SourceType, EML_TileType IntoType, TConstArrayView<FWord> SeedMask, FML_BoardChangeBuckets& OutChanges) const;
+	
+	// Mask of the given tiles and of their neighbors
+	void MakeNeighborhoodMask(TConstArrayView<int32> Indices, TArray<FWord>& OutMask) const;
+
+	// Adds one change per set bit of Mask to the Distance bucket, in board index order
+	void AppendChanges(TConstArrayView<FWord> Mask, EML_TileType TargetType, int32 Distance, FML_BoardChangeBuckets& OutChanges) const;
+
+private:
+	TSharedPtr<const FML_BoardLayout> Layout;
+
+	int32 Stride = 0;
+	int32 NumWords = 0;
+
+	TArray<FWord> BoardMask;
+
+	// NumTileTypes * NumWords, one mask per tile type
+	TArray<FWord> TypeMasks;
+
+	static void SetBit(FWord* Words, const int32 Bit) { Words[Bit / BitsPerWord] |= FWord(1) << (Bit % BitsPerWord); }
+	static void ClearBit(FWord* Words, const int32 Bit) { Words[Bit / BitsPerWord] &= ~(FWord(1) << (Bit % BitsPerWord)); }
+};
@@ -0,0 +1,87 @@
+﻿// Copyright Myceland Team, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/ML_CoreData.h"
+
+/** One change computed by a wave on a board state, addressed by dense tile index. */
+struct FML_BoardChange
+{
+	int32 TileIndex = INDEX_NONE;
+	EML_TileType TargetType = EML_TileType::Dirt;
+	int32 DistanceFromOrigin = 0;
+
+	// Collectible change: the tile receives a collectible, TargetType is ignored
+	bool bSpawnCollectible = false;
+
+	FML_BoardChange() = default;
+	FML_BoardChange(const int32 InTileIndex, const EML_TileType InType, const int32 InDistance) : TileIndex(InTileIndex), TargetType(InType), DistanceFromOrigin(InDistance) {}
+
+	static FML_BoardChange Collectible(const int32 InTileIndex, const int32 InDistance)
+	{
+		FML_BoardChange Change;
+		Change.TileIndex = InTileIndex;
+		Change.DistanceFromOrigin = InDistance;
+		Change.bSpawnCollectible = true;
+		return Change;
+	}
+};
+
+/**
+ * Output of a wave, one bucket per distance from the origin.
+ * Distances are small integers: a change goes straight into its bucket, and walking the buckets
+ * in order replaces sorting by distance. Inside a bucket, changes keep the order they were added in.
+ * Reset keeps the allocations, so the same buckets serve every wave of a turn.
+ */
+struct FML_BoardChangeBuckets
+{
+	void Reset()
+	{
+		for (int32 Distance = 0; Distance < NumUsedBuckets; ++Distance)
+		{
+			Buckets[Distance].Reset();
+		}
+		NumUsedBuckets = 0;
+		NumChanges = 0;
+	}
+
+	void Add(const FML_BoardChange& Change)
+	{
+		const int32 Distance = Change.DistanceFromOrigin;
+		check(Distance >= 0);
+
+		if (Distance >= Buckets.Num()) Buckets.SetNum(Distance + 1);
+		NumUsedBuckets = FMath::Max(NumUsedBuckets, Distance + 1);
+
+		Buckets[Distance].Add(Change);
+		++NumChanges;
+	}
+
+	int32 Num() const { return NumChanges; }
+	bool IsEmpty() const { return NumChanges == 0; }
+
+	// One past the largest distance added since Reset
+	int32 GetNumBuckets() const { return NumUsedBuckets; }
+
+	// Changes at Distance, can be empty
+	TConstArrayView<FML_BoardChange> GetBucket(const int32 Distance) const { return Buckets[Distance]; }
+
+	// Calls Func on every change, by increasing distance
+	template <typename FuncType>
+	void ForEach(FuncType&& Func) const
+	{
+		for (int32 Distance = 0; Distance < NumUsedBuckets; ++Distance)
+		{
+			for (const FML_BoardChange& Change : Buckets[Distance])
+			{
+				Func(Change);
+			}
+		}
+	}
+
+private:
+	TArray<TArray<FML_BoardChange>> Buckets;
+	int32 NumUsedBuckets = 0;
+	int32 NumChanges = 0;
+};
@@ -0,0 +1,50 @@
+﻿// Copyright Myceland Team, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Dense description of a hex board.
+ * Every axial coordinate of the board maps to a contiguous tile index in [0, Num()),
+ * and the 6 neighbors of every tile are precomputed once when the layout is built.
+ * Neighbor slots follow the global Directions table and hold INDEX_NONE when off board.
+ */
+struct MYCELAND_API FML_BoardLayout
+{
+	static constexpr int32 NumNeighbors = 6;
+
+	// Builds the layout from a set of unique axial coordinates. Indices are row-major (R, then Q).
+	void Build(TConstArrayView<FIntPoint> InAxials);
+	void Reset();
+
+	int32 Num() const { return Axials.Num(); }
+	bool IsValidIndex(const int32 Index) const { return Axials.IsValidIndex(Index); }
+
+	// Returns INDEX_NONE if the coordinate is not part of the board.
+	int32 IndexOf(const FIntPoint& Axial) const;
+
+	const FIntPoint& GetAxial(const int32 Index) const { return Axials[Index]; }
+	const TArray<FIntPoint>& GetAxials() const { return Axials; }
+
+	int32 GetNeighborIndex(const int32 Index, const int32 DirIndex) const { return NeighborTable[Index * NumNeighbors + DirIndex]; }
+	TConstArrayView<int32> GetNeighborIndices(const int32 Index) const { return MakeArrayView(NeighborTable.GetData() + Index * NumNeighbors, NumNeighbors); }
+
+	// Axial bounding box of the board
+	const FIntPoint& GetMinAxial() const { return MinAxial; }
+	int32 GetWidth() const { return Width; }
+	int32 GetHeight() const { return Height; }
+
+private:
+	TArray<FIntPoint> Axials;
+
+	// 6 entries per tile, INDEX_NONE when the neighbor is off board
+	TArray<int32> NeighborTable;
+
+	// Bounding box lookup (row-major on R), INDEX_NONE for holes
+	TArray<int32> CellToIndex;
+
+	FIntPoint MinAxial = FIntPoint::ZeroValue;
+	int32 Width = 0;
+	int32 Height = 0;
+};
@@ -0,0 +1,79 @@
+﻿// Copyright Myceland Team, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/ML_BoardBitboard.h"
+#include "Core/ML_BoardChange.h"
+#include "Core/ML_BoardLayout.h"
+#include "Core/ML_CoreData.h"
+#include "Core/ML_WaterComponents.h"
+
+/**
+ * Actor-free state of a board: tile types, collectible flags and consumed-grass flags, indexed by the board layout.
+ * Waves are computed against it and the actor layer only applies the resulting changes.
+ * Plain data and cheap to copy, so simulations never need a world.
+ */
+struct MYCELAND_API FML_BoardState
+{
+	FML_BoardState() = default;
+	explicit FML_BoardState(const TSharedRef<const FML_BoardLayout>& InLayout) { Init(InLayout); }
+
+	// Resets every tile to Dirt without collectible
+	void Init(const TSharedRef<const FML_BoardLayout>& InLayout);
+
+	bool IsValid() const { return Layout.IsValid(); }
+	const FML_BoardLayout& GetLayout() const { return *Layout; }
+	const TSharedPtr<const FML_BoardLayout>& GetLayoutPtr() const { return Layout; }
+
+	int32 Num() const { return Types.Num(); }
+	bool IsValidIndex(const int32 Index) const { return Types.IsValidIndex(Index); }
+	TConstArrayView<int32> GetNeighbors(const int32 Index) const { return Layout->GetNeighborIndices(Index); }
+
+	EML_TileType GetType(const int32 Index) const { return Types[Index]; }
+	void SetType(const int32 Index, const EML_TileType NewType);
+	
+	// Per-type bitsets kept in sync with the tile types
+	const FML_BoardBitboard& GetBitboard() const { return Bitboard; }
+	
+	// Id of the connected water body of Index, INDEX_NONE if Index is not water. Ids are board indices.
+	int32 GetWaterComponent(const int32 Index) const { return WaterComponents.GetComponent(Index); }
+
+	bool HasCollectible(const int32 Index) const { return Collectibles[Index]; }
+	void SetHasCollectible(const int32 Index, const bool bNewValue);
+
+	bool HasConsumedGrass(const int32 Index) const { return ConsumedGrass[Index]; }
+	void SetConsumedGrass(const int32 Index, const bool bNewValue) { ConsumedGrass[Index] = bNewValue; }
+
+	// Applies a wave change with the same rules as AML_Tile::UpdateClassAtRuntime (Grass -> Parasite flags consumed grass)
+	// Returns true if the board changed
+	bool ApplyChange(const FML_BoardChange& Change);
+	
+	// Zobrist hash of (type, collectible) over every tile, updated with each change (FML_Zobrist)
+	uint64 GetHash() const { return Hash; }
+	
+	// Change journal: every type or collectible change appends its tile index.
+	// Readers keep the serial of their last read and get the tiles changed since.
+	uint32 GetChangeSerial() const { return JournalBase + ChangeJournal.Num(); }
+	
+	// False when the journal no longer goes back to Serial (board rebuilt or journal trimmed): treat every tile as changed
+	bool GetChangesSince(uint32 Serial, TConstArrayView<int32>& OutChangedTiles) const;
+
+private:
+	TSharedPtr<const FML_BoardLayout> Layout;
+
+	TArray<EML_TileType> Types;
+	FML_BoardBitboard Bitboard;
+	FML_WaterComponents WaterComponents;
+	TBitArray<> Collectibles;
+	TBitArray<> ConsumedGrass;
+	uint64 Hash = 0;
+	
+	TArray<int32> ChangeJournal;
+	
+	// Serial of ChangeJournal[0], bumped past every serial handed out when the journal is dropped
+	uint32 JournalBase = 1;
+	
+	void RecordChange(int32 Index);
+	void ResetJournal();
+};
@@ -86,6 +86,20 @@ enum class EML_PlayerMovementMode : uint8
 	FreeMovement   // Free movement off the board
 };
 
+UENUM(BlueprintType)
+enum class EML_WaveRuleCondition : uint8
+{
+	None,
+	TouchesConnectedWater UMETA(ToolTip="The victim touches a water body connected to the spreading tiles (grass rule)")
+};
+
+UENUM(BlueprintType)
+enum class EML_WaveRulePropagation : uint8
+{
+	Flood    UMETA(ToolTip="Converted tiles keep spreading with their new type"),
+	Adjacent UMETA(ToolTip="Only the neighbors of the tiles present before the wave are converted")
+};
+
 
 // ==================== STRUCT ====================
 
@@ -174,3 +188,64 @@ struct FML_TileGroup
 	UPROPERTY(BlueprintReadOnly)
 	TArray<AML_Tile*> Goals;
 };
+
+// One tile turned by a wave step, see UML_WavePropagationSubsystem::OnWaveStepApplied
+USTRUCT(BlueprintType)
+struct FML_TileTypeChange
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	AML_Tile* Tile = nullptr;
+
+	UPROPERTY(BlueprintReadOnly)
+	EML_TileType OldType = EML_TileType::Dirt;
+
+	UPROPERTY(BlueprintReadOnly)
+	EML_TileType NewType = EML_TileType::Dirt;
+};
+
+// One cellular-automaton rule of a UML_WaveRuleSet: a Source tile turns its Victim neighbors into Result
+USTRUCT(BlueprintType)
+struct FML_WaveRule
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	EML_TileType SourceType = EML_TileType::Parasite;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	EML_TileType VictimType = EML_TileType::Grass;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	EML_TileType ResultType = EML_TileType::Parasite;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	EML_WaveRuleCondition Condition = EML_WaveRuleCondition::None;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	EML_WaveRulePropagation Propagation = EML_WaveRulePropagation::Flood;
+};
+
+// Predicted outcome of planting a tile, see UML_WavePropagationSubsystem::RequestPlantPreview
+USTRUCT(BlueprintType)
+struct FML_PlantPreview
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	AML_Tile* OriginTile = nullptr;
+
+	// Tiles whose type differs once the turn is over: current type -> final type
+	UPROPERTY(BlueprintReadOnly)
+	TArray<FML_TileTypeChange> TileChanges;
+
+	UPROPERTY(BlueprintReadOnly)
+	TArray<AML_Tile*> CollectibleTiles;
+
+	UPROPERTY(BlueprintReadOnly)
+	bool bWin = false;
+
+	UPROPERTY(BlueprintReadOnly)
+	bool bPlayerKilled = false;
+};
@@ -0,0 +1,150 @@
+﻿// Copyright Myceland Team, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Algo/Reverse.h"
+#include "Core/ML_BoardLayout.h"
+
+// What the search does with a tile once it is visited
+enum class EML_HexBFSVisit : uint8
+{
+	Expand,		// Enqueue its neighbors
+	Skip,		// Keep it visited but do not expand it
+	Stop		// End the search now (early exit)
+};
+
+/**
+ * Reusable buffers of FML_HexBFS, indexed by board index.
+ * Visit marks are stamped with a generation, so starting a new search never clears them.
+ * Keep one per call site (member or thread_local), never share it between two searches running at once.
+ */
+struct FML_HexBFSScratch
+{
+	// Visit order, sources first, distances never decrease
+	TArray<int32> Queue;
+
+	void Begin(const int32 NumTiles)
+	{
+		if (VisitStamps.Num() != NumTiles)
+		{
+			VisitStamps.Init(0, NumTiles);
+			Distances.SetNumUninitialized(NumTiles);
+			Parents.SetNumUninitialized(NumTiles);
+			Generation = 0;
+		}
+
+		// Stamps wrapped around: old marks could match the new generation
+		if (++Generation == 0)
+		{
+			FMemory::Memzero(VisitStamps.GetData(), VisitStamps.Num() * sizeof(uint32));
+			Generation = 1;
+		}
+
+		Queue.Reset();
+	}
+
+	bool IsVisited(const int32 Index) const { return VisitStamps[Index] == Generation; }
+
+	void Visit(const int32 Index, const int32 Distance, const int32 Parent)
+	{
+		VisitStamps[Index] = Generation;
+		Distances[Index] = Distance;
+		Parents[Index] = Parent;
+		Queue.Add(Index);
+	}
+
+	// Only meaningful for visited tiles. Sources have distance 0 and no parent (INDEX_NONE).
+	int32 GetDistance(const int32 Index) const { return Distances[Index]; }
+	int32 GetParent(const int32 Index) const { return Parents[Index]; }
+
+	// Source -> Target through the parents, empty if Target was not visited
+	void GetPathTo(const int32 Target, TArray<int32>& OutPath) const
+	{
+		OutPath.Reset();
+		if (!VisitStamps.IsValidIndex(Target) || !IsVisited(Target)) return;
+
+		for (int32 Index = Target; Index != INDEX_NONE; Index = Parents[Index])
+		{
+			OutPath.Add(Index);
+		}
+		Algo::Reverse(OutPath);
+	}
+
+private:
+	TArray<uint32> VisitStamps;
+	TArray<int32> Distances;
+	TArray<int32> Parents;
+	uint32 Generation = 0;
+};
+
+/**
+ * Default policy of FML_HexBFS. Policies derive from it and hide the members they need:
+ * - CanEnter: traversal rule, checked when a neighbor is discovered
+ * - OnVisit: called in BFS order (sources at distance 0 included), decides to expand, skip or stop
+ * - OnLayerComplete: called once every tile at Distance was visited
+ * Calls are resolved at compile time, every policy gets its own loop.
+ */
+struct FML_HexBFSPolicy
+{
+	bool CanEnter(const int32 FromIndex, const int32 ToIndex) const { return true; }
+	EML_HexBFSVisit OnVisit(const int32 Index, const int32 Distance) { return EML_HexBFSVisit::Expand; }
+	void OnLayerComplete(const int32 Distance) {}
+};
+
+struct FML_HexBFS
+{
+	// Breadth-first search from Sources over the board layout.
+	// Returns the index the policy stopped on, INDEX_NONE if the search ran out of tiles.
+	template <typename PolicyType>
+	static int32 Run(const FML_BoardLayout& Layout, const TConstArrayView<int32> Sources, PolicyType& Policy, FML_HexBFSScratch& Scratch)
+	{
+		Scratch.Begin(Layout.Num());
+
+		for (const int32 Source : Sources)
+		{
+			if (Layout.IsValidIndex(Source) && !Scratch.IsVisited(Source))
+			{
+				Scratch.Visit(Source, 0, INDEX_NONE);
+			}
+		}
+
+		int32 LayerDistance = 0;
+		for (int32 Head = 0; Head < Scratch.Queue.Num(); ++Head)
+		{
+			const int32 Current = Scratch.Queue[Head];
+			const int32 Distance = Scratch.GetDistance(Current);
+
+			if (Distance != LayerDistance)
+			{
+				Policy.OnLayerComplete(LayerDistance);
+				LayerDistance = Distance;
+			}
+
+			const EML_HexBFSVisit Visit = Policy.OnVisit(Current, Distance);
+			if (Visit == EML_HexBFSVisit::Stop) return Current;
+			if (Visit == EML_HexBFSVisit::Skip) continue;
+
+			for (const int32 Neighbor : Layout.GetNeighborIndices(Current))
+			{
+				if (Neighbor == INDEX_NONE || Scratch.IsVisited(Neighbor)) continue;
+				if (!Policy.CanEnter(Current, Neighbor)) continue;
+
+				Scratch.Visit(Neighbor, Distance + 1, Current);
+			}
+		}
+
+		if (Scratch.Queue.Num() > 0)
+		{
+			Policy.OnLayerComplete(LayerDistance);
+		}
+
+		return INDEX_NONE;
+	}
+
+	template <typename PolicyType>
+	static int32 Run(const FML_BoardLayout& Layout, const int32 Source, PolicyType& Policy, FML_HexBFSScratch& Scratch)
+	{
+		return Run(Layout, MakeArrayView(&Source, 1), Policy, Scratch);
+	}
+};
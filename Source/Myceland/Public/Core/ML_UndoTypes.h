@@ -30,6 +30,9 @@ struct FML_SpawnUndoDelta
 
 	UPROPERTY() TWeakObjectPtr<AActor> SpawnedActor;
 
+	// Pooled collectibles are reused, only undo the spawn if the actor was not recycled since
+	UPROPERTY() int32 PoolGeneration = INDEX_NONE;
+
 	// ordering
 	UPROPERTY() int32 PriorityIndex = 0;
 	UPROPERTY() int32 DistanceFromOrigin = 0;
@@ -0,0 +1,42 @@
+﻿// Copyright Myceland Team, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/ML_BoardLayout.h"
+#include "Core/ML_CoreData.h"
+
+/**
+ * Connected water bodies of a board, as a union-find over the board indices (union by size, no path compression
+ * so lookups stay const). Tiles turning into water are merged with their water neighbors, a tile leaving water
+ * splits its body and rebuilds every label.
+ */
+struct MYCELAND_API FML_WaterComponents
+{
+	// No water
+	void Reset(int32 NumTiles);
+
+	void Rebuild(const FML_BoardLayout& Layout, TConstArrayView<EML_TileType> Types);
+
+	// Index just turned into water, Types already holds its new type
+	void AddWater(const FML_BoardLayout& Layout, TConstArrayView<EML_TileType> Types, int32 Index);
+
+	// Component id of the water body of Index (in [0, NumTiles)), INDEX_NONE when Index is not water
+	int32 GetComponent(const int32 Index) const
+	{
+		int32 Root = Parents[Index];
+		if (Root == INDEX_NONE) return INDEX_NONE;
+
+		while (Parents[Root] != Root) Root = Parents[Root];
+		return Root;
+	}
+
+private:
+	// INDEX_NONE for non water tiles, roots point to themselves
+	TArray<int32> Parents;
+
+	// Tile count of the component, valid on roots
+	TArray<int32> Sizes;
+
+	void Union(int32 A, int32 B);
+};
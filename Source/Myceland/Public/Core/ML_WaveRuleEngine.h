@@ -0,0 +1,63 @@
+﻿// Copyright Myceland Team, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/ML_BoardBitboard.h"
+#include "Core/ML_CoreData.h"
+
+struct FML_BoardState;
+struct FML_BoardChangeBuckets;
+
+/**
+ * Wave rules (FML_WaveRule) compiled into a dense (source type, victim type) table.
+ * A run is one BFS from every tile of a source type: a neighbor is converted when the type of the tile reaching it
+ * and its own type have a rule whose condition holds, at its distance from the nearest source.
+ * Each tile converts at most once per run. A single unconditional flood rule runs on the bitboard instead.
+ */
+struct MYCELAND_API FML_CompiledWaveRules
+{
+	struct FPairRule
+	{
+		bool bValid = false;
+		EML_TileType Result = EML_TileType::Dirt;
+		EML_WaveRuleCondition Condition = EML_WaveRuleCondition::None;
+		EML_WaveRulePropagation Propagation = EML_WaveRulePropagation::Flood;
+	};
+
+	// First rule of a (source, victim) pair wins, rules converting a type into itself are dropped
+	static FML_CompiledWaveRules Compile(TConstArrayView<FML_WaveRule> Rules);
+
+	bool IsEmpty() const { return SourceMask == 0; }
+
+	// Unique per Compile call, tells the rules of a turn apart from the ones compiled after an edit
+	uint32 GetVersion() const { return Version; }
+
+	// Source of a TouchesConnectedWater rule: the water network grows from these tiles only, like grass in UML_WaveGrass
+	bool IsWaterSource(const EML_TileType Type) const { return (WaterSourceMask & (1u << static_cast<uint32>(Type))) != 0; }
+
+	const FPairRule& GetPairRule(const EML_TileType Source, const EML_TileType Victim) const
+	{
+		return Pairs[static_cast<int32>(Source) * NumTypes + static_cast<int32>(Victim)];
+	}
+
+	void Execute(const FML_BoardState& State, FML_BoardChangeBuckets& OutChanges) const;
+
+private:
+	static constexpr int32 NumTypes = FML_BoardBitboard::NumTileTypes;
+
+	TStaticArray<FPairRule, NumTypes * NumTypes> Pairs;
+
+	uint32 Version = 0;
+
+	// Bit per tile type that is the source of a rule
+	uint32 SourceMask = 0;
+
+	// Bit per tile type that is the source of a TouchesConnectedWater rule
+	uint32 WaterSourceMask = 0;
+
+	// Lone Source -> Victim flood rule whose result is Source: FML_BoardBitboard::FloodFill
+	bool bBitboardFlood = false;
+	EML_TileType FloodSource = EML_TileType::Dirt;
+	EML_TileType FloodVictim = EML_TileType::Dirt;
+};
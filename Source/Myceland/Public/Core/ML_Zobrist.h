@@ -0,0 +1,33 @@
+﻿// Copyright Myceland Team, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/ML_BoardBitboard.h"
+#include "Core/ML_CoreData.h"
+
+/**
+ * Keys of the Zobrist board hash (FML_BoardState::GetHash): one 64-bit key per (tile, feature),
+ * the hash being the XOR of the keys of every feature present. Keys are a fixed mix of the tile index,
+ * so hashes match across boards, sessions and platforms without a table.
+ */
+struct FML_Zobrist
+{
+	// splitmix64 finalizer
+	static uint64 Mix(uint64 Value)
+	{
+		Value += 0x9E3779B97F4A7C15ull;
+		Value = (Value ^ (Value >> 30)) * 0xBF58476D1CE4E5B9ull;
+		Value = (Value ^ (Value >> 27)) * 0x94D049BB133111EBull;
+		return Value ^ (Value >> 31);
+	}
+
+	static uint64 TypeKey(const int32 Index, const EML_TileType Type) { return Mix(uint64(Index) * NumFeatures + static_cast<uint64>(Type)); }
+	static uint64 CollectibleKey(const int32 Index) { return Mix(uint64(Index) * NumFeatures + FML_BoardBitboard::NumTileTypes); }
+
+	// Parasite that ate grass and waits for the collectible wave, part of the wave cycle state
+	static uint64 PendingParasiteKey(const int32 Index) { return Mix(uint64(Index) * NumFeatures + FML_BoardBitboard::NumTileTypes + 1); }
+
+private:
+	static constexpr uint64 NumFeatures = FML_BoardBitboard::NumTileTypes + 2;
+};
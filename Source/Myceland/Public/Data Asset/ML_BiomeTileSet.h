@@ -13,6 +13,7 @@ class AML_Collectible;
 class AML_TileParasite;
 class AML_TileGrass;
 class AML_TileDirt;
+class UStaticMeshComponent;
 
 UCLASS()
 class MYCELAND_API UML_BiomeTileSet : public UDataAsset
@@ -38,4 +39,7 @@ private:
 public:
 	TSubclassOf<AML_TileBase> GetClassFromTileType(EML_TileType Type) const;
 	TSubclassOf<AML_Collectible> GetCollectibleClass() const { return CollectibleClass; }
+	
+	// Ground mesh of the tile class of this type (class defaults), nullptr for types without a class in the biome
+	const UStaticMeshComponent* GetGroundTemplate(EML_TileType Type) const;
 };
@@ -0,0 +1,35 @@
+﻿// Copyright Myceland Team, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/ML_CoreData.h"
+#include "Core/ML_WaveRuleEngine.h"
+#include "Engine/DataAsset.h"
+#include "ML_WaveRuleSet.generated.h"
+
+// Wave rules edited as data, compiled once on load (and on every edit in the editor).
+// An edit compiles new rules instead of changing the shared ones, so resolves in flight keep the rules they started with.
+UCLASS()
+class MYCELAND_API UML_WaveRuleSet : public UDataAsset
+{
+	GENERATED_BODY()
+
+private:
+	// First rule of a (source, victim) pair wins
+	UPROPERTY(EditDefaultsOnly)
+	TArray<FML_WaveRule> Rules;
+
+	TSharedPtr<const FML_CompiledWaveRules, ESPMode::ThreadSafe> CompiledRules;
+
+	void CompileRules();
+
+public:
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	const TArray<FML_WaveRule>& GetRules() const { return Rules; }
+	TSharedPtr<const FML_CompiledWaveRules, ESPMode::ThreadSafe> GetCompiledRules() const { return CompiledRules; }
+};
@@ -46,6 +46,18 @@ public:
 	UPROPERTY(EditAnywhere, config, BlueprintReadOnly, Category="Wave Propagation", meta=(Tooltip="Delay between each tiles in a wave (tile distance 1 (from clicked tile), DELAY, distance 2, DELAY, etc...)"))
 	float IntraWaveDelay = 0.3f;
 	
+	UPROPERTY(EditAnywhere, config, BlueprintReadOnly, Category="Wave Propagation", meta=(ClampMin="0.01", Tooltip="Speed of the waves playback (and undo playback), scales both delays"))
+	float WavePlaybackSpeed = 1.f;
+	
+	UPROPERTY(EditAnywhere, config, BlueprintReadOnly, Category="Wave Propagation", meta=(ClampMin="1", Tooltip="Extra speed applied on top of WavePlaybackSpeed while fast-forwarding"))
+	float WaveFastForwardSpeed = 4.f;
+	
+	UPROPERTY(EditAnywhere, config, BlueprintReadOnly, Category="Wave Propagation", meta=(Tooltip="Tiles changed by waves skip their own OnTileTypeChanged, the propagation subsystem's OnWaveStepApplied reports them once per distance step"))
+	bool bBatchTileChangeEvents = false;
+	
+	UPROPERTY(EditAnywhere, config, BlueprintReadOnly, Category="Wave Propagation", meta=(ClampMin="0", Tooltip="Number of resolved turns kept to replay without recomputing the waves (plant, undo, plant again). 0 disables the cache"))
+	int32 TurnCacheSize = 32;
+	
 	
 	
 	// ==================== Helper ====================
@@ -29,6 +29,8 @@ private:
 	AML_PlayerController* MycelandController;
 	
 	void UpdateCurrentTile();
+	AML_Tile* FindTileOnBoards() const;
+	AML_Tile* TraceTileBelow() const;
 	void HandleTileStateChange(const AML_Tile* OldTile, const AML_Tile* NewTile) const;
 
 protected:
@@ -4,8 +4,10 @@
 
 #include "CoreMinimal.h"
 #include "Core/ML_CoreData.h"
+#include "Core/ML_HexBFS.h"
 #include "Developer Settings/ML_MycelandDeveloperSettings.h"
 #include "GameFramework/PlayerController.h"
+#include "Tiles/ML_BoardView.h"
 #include "ML_PlayerController.generated.h"
 
 class UML_MycelandDeveloperSettings;
@@ -88,15 +90,17 @@ private:
 
 	AML_Tile* GetTileUnderCursor() const;
 	bool IsTileWalkable(const AML_Tile* Tile) const;
-	AML_Tile* FindNearestWalkableTile(const FVector& WorldLocation, const TMap<FIntPoint, AML_Tile*>& GridMap) const;
+	AML_Tile* FindNearestWalkableTile(const FVector& WorldLocation, const FML_BoardView& BoardView) const;
 
 	// ==================== Pathfinding ====================
 
-	bool BuildPath_AxialBFS(const FIntPoint& StartAxial, const FIntPoint& GoalAxial, const TMap<FIntPoint, AML_Tile*>& GridMap, TArray<FIntPoint>& OutAxialPath) const;
+	bool BuildPath_AxialBFS(const FIntPoint& StartAxial, const FIntPoint& GoalAxial, const FML_BoardView& BoardView, TArray<FIntPoint>& OutAxialPath) const;
+	
+	mutable FML_HexBFSScratch PathScratch;
 
 	// ==================== Movement ====================
 
-	void StartMoveAlongPath(const TArray<FIntPoint>& AxialPath, const TMap<FIntPoint, AML_Tile*>& GridMap);
+	void StartMoveAlongPath(const TArray<FIntPoint>& AxialPath, const FML_BoardView& BoardView);
 	void StartMoveToWorldLocation(const FVector& WorldLocation);
 	void TickMoveAlongPath(float DeltaTime);
 	void OnPathFinished();
@@ -156,12 +160,21 @@ protected:
     
 	UPROPERTY(Transient)
 	AML_Tile* LastHoveredTile = nullptr;
+
+	// Board change serial when LastHoveredTile was previewed (FML_BoardState::GetChangeSerial)
+	uint32 LastHoveredBoardSerial = 0;
+
+	// The subsystem refused the last plant preview (turn playing), asked again while the hover stays
+	bool bPlantPreviewPending = false;
     
 	UPROPERTY(Transient)
 	TArray<AML_Tile*> CurrentPreviewPath;
     
 	void TickHoverPreview(float DeltaTime);
 	void ClearHoverPreview();
+
+	// Asks the wave subsystem for the outcome of planting the hovered tile (UML_WavePropagationSubsystem::OnPlantPreviewReady)
+	void UpdatePlantPreview(AML_Tile* HoveredTile);
 	TArray<AML_Tile*> BuildPreviewPath(const AML_Tile* TargetTile) const;
 
 public:
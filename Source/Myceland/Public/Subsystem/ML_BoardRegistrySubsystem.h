@@ -0,0 +1,45 @@
+﻿// Copyright Myceland Team, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ML_BoardRegistrySubsystem.generated.h"
+
+class AML_BoardSpawner;
+class AML_Tile;
+
+/**
+ * Index of the boards of the world and of the tiles they own, so lookups never scan the world actors.
+ * Boards and tiles register themselves when their components are registered (editor and game worlds).
+ */
+UCLASS()
+class MYCELAND_API UML_BoardRegistrySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+private:
+	TSet<TWeakObjectPtr<AML_BoardSpawner>> Boards;
+	TMap<TWeakObjectPtr<AML_BoardSpawner>, TSet<TWeakObjectPtr<AML_Tile>>> BoardTiles;
+	TMap<TWeakObjectPtr<const AML_Tile>, TWeakObjectPtr<AML_BoardSpawner>> TileBoards;
+
+public:
+	virtual void Deinitialize() override;
+
+	void RegisterBoard(AML_BoardSpawner* Board);
+
+	// Tiles stay registered: a board re-registering its components (editor) must still find them
+	void UnregisterBoard(AML_BoardSpawner* Board);
+
+	// Moves the tile to Board if it was registered with another board
+	void RegisterTile(AML_Tile* Tile, AML_BoardSpawner* Board);
+	void UnregisterTile(const AML_Tile* Tile);
+
+	AML_BoardSpawner* FindBoardForTile(const AML_Tile* Tile) const;
+
+	// Valid tiles registered with Board, in no particular order
+	void GetTilesOfBoard(const AML_BoardSpawner* Board, TArray<AML_Tile*>& OutTiles) const;
+
+	UFUNCTION(BlueprintPure, Category="Myceland|Board Registry")
+	TArray<AML_BoardSpawner*> GetBoards() const;
+};
@@ -0,0 +1,60 @@
+﻿// Copyright Myceland Team, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ML_CollectiblePoolSubsystem.generated.h"
+
+class AML_Collectible;
+class AML_Tile;
+
+USTRUCT()
+struct FML_CollectiblePool
+{
+	GENERATED_BODY()
+
+	// Hidden collectibles ready to be reused
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AML_Collectible>> Free;
+};
+
+/**
+ * Reuses collectible actors for wave spawns and undo restores instead of spawning and destroying them.
+ * Pools are keyed by collectible class (UML_BiomeTileSet::GetCollectibleClass).
+ */
+UCLASS()
+class MYCELAND_API UML_CollectiblePoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+private:
+	UPROPERTY(Transient)
+	TMap<TSubclassOf<AML_Collectible>, FML_CollectiblePool> Pools;
+
+	int32 PoolHits = 0;
+	int32 PoolMisses = 0;
+
+public:
+	virtual void Deinitialize() override;
+
+	// Returns an active collectible at Location owned by OwningTile, reused from the pool when possible
+	AML_Collectible* Acquire(TSubclassOf<AML_Collectible> CollectibleClass, const FVector& Location, AML_Tile* OwningTile);
+
+	// Deactivates the collectible and keeps it for the next Acquire. Releasing a pooled collectible does nothing.
+	void Release(AML_Collectible* Collectible);
+
+	void Prewarm(TSubclassOf<AML_Collectible> CollectibleClass, int32 Count);
+
+	UFUNCTION(BlueprintPure, Category="Myceland|Collectible Pool")
+	int32 GetPoolHits() const { return PoolHits; }
+
+	UFUNCTION(BlueprintPure, Category="Myceland|Collectible Pool")
+	int32 GetPoolMisses() const { return PoolMisses; }
+
+	UFUNCTION(BlueprintPure, Category="Myceland|Collectible Pool")
+	int32 GetNumPooled() const;
+
+	UFUNCTION(BlueprintCallable, Category="Myceland|Collectible Pool")
+	void ResetPoolStats() { PoolHits = 0; PoolMisses = 0; }
+};
@@ -4,7 +4,13 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "Containers/LruCache.h"
+#include "Tasks/Task.h"
 #include "Core/ML_UndoTypes.h"
+#include "UObject/ObjectKey.h"
+#include "Waves/ML_WaveResolver.h"
+#include "Waves/ML_WavePlayback.h"
+#include "Waves/ML_WavePipeline.h"
 #include "ML_WavePropagationSubsystem.generated.h"
 
 struct FML_WaveChange;
@@ -15,27 +21,134 @@ class AML_PlayerCharacter;
 class AML_BoardSpawner;
 class AML_Tile;
 class AML_Collectible;
+class UML_CollectiblePoolSubsystem;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnTurnResolved, bool, bWin, bool, bPlayerKilled);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPlantPreviewReady, const FML_PlantPreview&, Preview);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnPlantPreviewCleared);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FOnWaveStepApplied, AML_BoardSpawner*, Board, int32, PriorityIndex, int32, DistanceFromOrigin, const TArray<FML_TileTypeChange>&, Changes);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnAmbientTurnFinished, AML_BoardSpawner*, Board);
+
+// Identifies a turn whose outcome only depends on its inputs
+struct FML_TurnCacheKey
+{
+	TObjectKey<AML_BoardSpawner> Board;
+
+	// Board layout the state was taken on, kept alive by the cached timeline (FML_WaveTimeline::FinalState)
+	const FML_BoardLayout* Layout = nullptr;
+
+	uint64 StateHash = 0;
+	int32 OriginIndex = INDEX_NONE;
+	int32 PlayerIndex = INDEX_NONE;
+
+	// FML_WavePipeline::GetRulesVersion: a turn cached before a rule set edit is not replayed with the old rules
+	uint32 RulesVersion = 0;
+
+	FML_TurnCacheKey(const AML_BoardSpawner* InBoard, const FML_BoardState& State, const int32 InOriginIndex, const int32 InPlayerIndex, const uint32 InRulesVersion)
+		: Board(InBoard), Layout(&State.GetLayout()), StateHash(State.GetHash()), OriginIndex(InOriginIndex), PlayerIndex(InPlayerIndex), RulesVersion(InRulesVersion) {}
+
+	bool operator==(const FML_TurnCacheKey& Other) const
+	{
+		return Board == Other.Board && Layout == Other.Layout && StateHash == Other.StateHash
+			&& OriginIndex == Other.OriginIndex && PlayerIndex == Other.PlayerIndex && RulesVersion == Other.RulesVersion;
+	}
+
+	friend uint32 GetTypeHash(const FML_TurnCacheKey& Key)
+	{
+		return HashCombine(HashCombine(GetTypeHash(Key.StateHash), GetTypeHash(Key.Board)),
+		                   HashCombine(HashCombine(GetTypeHash(Key.OriginIndex), GetTypeHash(Key.PlayerIndex)), GetTypeHash(Key.RulesVersion)));
+	}
+};
+
+// Turn of a board the player is not on (ambient, scripted), resolved on a worker thread then played next to the player's turn.
+// No undo record and no win/lose check.
+struct FML_AmbientBoardTurn
+{
+	TWeakObjectPtr<AML_BoardSpawner> Board;
+	TWeakObjectPtr<AML_Tile> OriginTile;
+
+	FML_TurnCacheKey CacheKey;
+
+	// Board change serial the turn was resolved on, the turn is dropped if the board changed meanwhile
+	uint32 ResolveSerial = 0;
+
+	// Invalid once the timeline is known
+	UE::Tasks::TTask<FML_WaveTimeline> Task;
+	TSharedPtr<std::atomic<bool>, ESPMode::ThreadSafe> CancelFlag;
+
+	FML_WaveTimeline Timeline;
+	FML_WavePlaybackScheduler Playback;
+
+	// Play every step as soon as the timeline is known
+	bool bSkipPlayback = false;
+	bool bFinished = false;
+
+	// Finished without being played: board destroyed, changed while the worker ran, or planted on before the worker ended
+	bool bDropped = false;
+
+	FML_AmbientBoardTurn(AML_BoardSpawner* InBoard, AML_Tile* InOriginTile, const FML_TurnCacheKey& InCacheKey, const uint32 InResolveSerial)
+		: Board(InBoard), OriginTile(InOriginTile), CacheKey(InCacheKey), ResolveSerial(InResolveSerial) {}
+};
+
+// Result of a plant preview resolved on a worker thread
+struct FML_PlantPreviewOutcome
+{
+	FML_WaveTimeline Timeline;
+	bool bWin = false;
+};
 
 UCLASS()
-class MYCELAND_API UML_WavePropagationSubsystem : public UWorldSubsystem
+class MYCELAND_API UML_WavePropagationSubsystem : public UTickableWorldSubsystem
 {
 	GENERATED_BODY()
 
 private:
 	UPROPERTY() UML_WinLoseSubsystem* WinLoseSubsystem = nullptr;
+	UPROPERTY() UML_CollectiblePoolSubsystem* CollectiblePool = nullptr;
 	UPROPERTY() AML_PlayerController* PlayerController = nullptr;
 	UPROPERTY() const UML_MycelandDeveloperSettings* DevSettings = nullptr;
 
-	UPROPERTY(Transient) TArray<FML_WaveChange> PendingChanges;
 	UPROPERTY(Transient) AML_Tile* CurrentOriginTile = nullptr;
-	UPROPERTY(Transient) TArray<AML_Tile*> ParasitesThatAteGrass;
+	UPROPERTY(Transient) AML_BoardSpawner* CurrentBoard = nullptr;
 
 	bool bIsResolvingTiles = false;
-	int32 CurrentWaveIndex = 0;
-	bool bCycleHasChanges = false;
 
-	FTimerHandle IntraWaveTimerHandle;
-	FTimerHandle InterWaveTimerHandle;
+	// WavesPriority compiled at initialization, and again when a wave class is reinstanced in the editor
+	FML_WavePipeline WavePipeline;
+
+	void CompileWavePipeline();
+
+#if WITH_EDITOR
+	FDelegateHandle ObjectsReinstancedHandle;
+	void OnObjectsReinstanced(const TMap<UObject*, UObject*>& ReplacementMap);
+#endif
+
+	// Resolved turns by inputs, sized by UML_MycelandDeveloperSettings::TurnCacheSize
+	TLruCache<FML_TurnCacheKey, FML_WaveTimeline> TurnCache;
+	int32 TurnCacheHits = 0;
+	int32 TurnCacheMisses = 0;
+
+	// ---- Plant preview ----
+	UE::Tasks::TTask<FML_PlantPreviewOutcome> PreviewTask;
+	TSharedPtr<std::atomic<bool>, ESPMode::ThreadSafe> PreviewCancelFlag;
+	TOptional<FML_TurnCacheKey> PreviewKey;
+	UPROPERTY(Transient) AML_Tile* PreviewTile = nullptr;
+
+	// Turn resolved up front by FML_WaveResolver, then played step by step
+	FML_WaveTimeline ActiveTimeline;
+
+	// Tiles turned by the step being applied, reused for every OnWaveStepApplied
+	UPROPERTY(Transient) TArray<FML_TileTypeChange> StepTileChanges;
+
+	// Paces both the turn timeline (one entry per step, then the end) and the undo groups (one per group, then the end)
+	FML_WavePlaybackScheduler Playback;
+	float PlaybackTimeScale = 1.f;
+	bool bIsPumpingPlayback = false;
+
+	// ---- Ambient boards ----
+	// One per board at most, heap allocated so that a turn stays put while its events run
+	TArray<TUniquePtr<FML_AmbientBoardTurn>> AmbientTurns;
+	bool bIsPumpingAmbientTurns = false;
 
 	// ---- Actions Undo stack ----
 	UPROPERTY(Transient) TArray<FML_ActionUndoRecord> ActionUndoStack;
@@ -54,14 +167,43 @@ private:
 	UPROPERTY(Transient) TArray<FML_TileUndoDelta> PendingUndoTileDeltas;
 	UPROPERTY(Transient) TArray<FML_SpawnUndoDelta> PendingUndoSpawnDeltas;
 
+	// (PriorityIndex, DistanceFromOrigin) of each undo group, in playback order
+	TArray<FIntPoint> UndoGroups;
+
 	bool bIsUndoAnimating = false;
+	
+	// Board change serial at the last run of each wave on each board (FML_BoardState::GetChangeSerial)
+	TMap<TPair<TObjectKey<AML_BoardSpawner>, TObjectKey<UClass>>, uint32> WaveChangeSerials;
 
 	// ---- Forward waves ----
-	void RunWave();
-	void ScheduleNextPriority();
-	void ProcessNextWave();
+	FML_WaveResolveParams MakeResolveParams(const AML_BoardSpawner* Board, int32 OriginIndex, int32 PlayerIndex) const;
+	void ResolveTurn();
+	void RecordResolvedTurn(const AML_BoardSpawner* Board, const AML_Tile* OriginTile, uint32 ResolveSerial, const FML_WaveTimeline& Timeline);
+	TArray<float> MakeTimelineDelays(const FML_WaveTimeline& Timeline) const;
+	void PlayTimelineSteps(int32 FirstStep, int32 NumEntries);
+	void ApplyTimelineStep(AML_BoardSpawner* Board, const FML_WaveTimeline& Timeline, const FML_WaveTimelineStep& Step, const AML_Tile* PlayerTile, bool bRecordUndo);
 	void EndTileResolved();
-	void CancelAllWaveTimers();
+
+	// ---- Ambient boards ----
+	bool HasAmbientTurn(const AML_BoardSpawner* Board) const;
+
+	// Undoing a turn of the stack on this board would restore tiles over the changes of an ambient turn
+	bool IsBoardInUndoStack(const AML_BoardSpawner* Board) const;
+	void PumpAmbientTurns(float DeltaTime);
+	void PlayAmbientTurn(FML_AmbientBoardTurn& Turn, float DeltaTime, const AML_Tile* PlayerTile);
+
+	// Plays what is left of the ambient turn of Board right away, drops it if its worker is still running.
+	// False if it could not (called from one of its events).
+	bool FinishAmbientTurn(const AML_BoardSpawner* Board);
+
+	// ---- Plant preview ----
+	void PollPlantPreview();
+	void DeliverPlantPreview(const FML_WaveTimeline& Timeline, bool bWin);
+
+	// ---- Playback ----
+	void StartPlayback(TArray<float>&& Delays);
+	void PumpPlayback(float DeltaTime);
+	void StopPlayback();
 
 	// ---- Turn record ----
 	void BeginTurnRecord_Internal(AML_Tile* OriginTile);
@@ -72,8 +214,8 @@ private:
 	void RecordSpawnedActor(AActor* Spawned, int32 DistanceFromOrigin);
 
 	// ---- Animated undo (Plant/Waves) ----
-	void RunUndoWave();
-	void ScheduleNextUndoWave(float Delay);
+	void StartUndoWaves();
+	void PlayUndoGroups(int32 FirstGroup, int32 NumEntries);
 	void FinishUndoAnimation();
 	void ApplyUndoWaveGroup(int32 PriorityIndex, int32 DistanceFromOrigin);
 
@@ -81,13 +223,76 @@ private:
 	void DestroyCollectibleActorOnTile(AML_Tile* Tile);
 
 public:
-	void EnsureInitialized();
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// ~ Begin FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return Playback.IsPlaying() || PreviewTask.IsValid() || AmbientTurns.Num() > 0; }
+	virtual TStatId GetStatId() const override;
+	// ~ End FTickableGameObject
 
-	// Called by collectible wave BEFORE flipping HasCollectible flag
-	void RecordTileForUndo(AML_Tile* Tile, int32 DistanceFromOrigin);
+	void EnsureInitialized();
 
 	UFUNCTION(BlueprintCallable, Category="Myceland Wave Propagation")
 	void BeginTileResolved(AML_Tile* HitTile);
+	
+	// Broadcast as soon as a turn is resolved, before its waves are played
+	UPROPERTY(BlueprintAssignable, Category="Myceland Wave Propagation")
+	FOnTurnResolved OnTurnResolved;
+	
+	// One call per played distance step with every tile it turned (collectible spawns excluded).
+	// Board tells the player's turn from ambient turns (IsPlayingAmbientTurn).
+	UPROPERTY(BlueprintAssignable, Category="Myceland Wave Propagation")
+	FOnWaveStepApplied OnWaveStepApplied;
+
+	// Applies the remaining waves of the turn (or of the undo) this frame
+	UFUNCTION(BlueprintCallable, Category="Myceland Wave Propagation")
+	void SkipWaveAnimation();
+
+	// Speeds up the waves playback by UML_MycelandDeveloperSettings::WaveFastForwardSpeed
+	UFUNCTION(BlueprintCallable, Category="Myceland Wave Propagation")
+	void SetWaveFastForward(bool bEnabled) { Playback.bFastForward = bEnabled; }
+
+	// Runtime multiplier on UML_MycelandDeveloperSettings::WavePlaybackSpeed (e.g. a game speed option).
+	// Clamped to FML_WavePlaybackScheduler::MinTimeScale, a paused playback would hold the turn forever.
+	UFUNCTION(BlueprintCallable, Category="Myceland Wave Propagation")
+	void SetWavePlaybackTimeScale(float InTimeScale);
+	
+	// Resolves the turn of planting Tile on a worker thread, on a copy of its board.
+	// OnPlantPreviewReady fires on the game thread, right away when the turn is cached. A new request cancels the previous one.
+	UFUNCTION(BlueprintCallable, Category="Myceland Wave Propagation|Preview")
+	bool RequestPlantPreview(AML_Tile* Tile);
+
+	// Drops the pending or delivered preview, OnPlantPreviewCleared fires when there was one
+	UFUNCTION(BlueprintCallable, Category="Myceland Wave Propagation|Preview")
+	void CancelPlantPreview();
+
+	UPROPERTY(BlueprintAssignable, Category="Myceland Wave Propagation|Preview")
+	FOnPlantPreviewReady OnPlantPreviewReady;
+
+	UPROPERTY(BlueprintAssignable, Category="Myceland Wave Propagation|Preview")
+	FOnPlantPreviewCleared OnPlantPreviewCleared;
+
+	// Starts a turn from each origin tile on its board, boards resolved in parallel on worker threads, played on the game thread.
+	// Skips the board of the player, boards with turns in the undo stack, boards still spawning and boards already playing an ambient turn.
+	// Returns the number of turns started.
+	UFUNCTION(BlueprintCallable, Category="Myceland Wave Propagation|Ambient")
+	int32 ResolveAmbientTurns(const TArray<AML_Tile*>& OriginTiles);
+
+	UFUNCTION(BlueprintPure, Category="Myceland Wave Propagation|Ambient")
+	bool IsPlayingAmbientTurn(const AML_BoardSpawner* Board) const { return HasAmbientTurn(Board); }
+
+	// Ambient turn played to its end (the steps fire OnWaveStepApplied like the player's turn)
+	UPROPERTY(BlueprintAssignable, Category="Myceland Wave Propagation|Ambient")
+	FOnAmbientTurnFinished OnAmbientTurnFinished;
+
+	// Resolved turns served from the cache vs computed, since the world started
+	UFUNCTION(BlueprintPure, Category="Myceland Wave Propagation")
+	void GetTurnCacheStats(int32& OutHits, int32& OutMisses, float& OutHitRate) const;
+
+	UFUNCTION(BlueprintPure, Category="Myceland Wave Propagation")
+	bool IsPlayingWaves() const { return bIsResolvingTiles; }
 
 	UFUNCTION(BlueprintPure, Category="Myceland|Undo")
 	bool CanUndo() const { return !bIsResolvingTiles && !bIsUndoAnimating && ActionUndoStack.Num() > 0; }
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "Core/ML_HexBFS.h"
 #include "Tiles/ML_BoardSpawner.h"
 #include "ML_WinLoseSubsystem.generated.h"
 
@@ -50,6 +51,11 @@ public:
 	                                        const TArray<EML_TileType>& AllowedPathTypes);
 	
 
+	// Same test on a board state, to know the result of a turn before it is played
+	static bool AreAllGoalsConnectedOnState(const FML_BoardState& State,
+	                                        EML_TileType GoalType,
+	                                        TConstArrayView<EML_TileType> AllowedPathTypes);
+
 	bool FindConnectedGoalGroups(
 		AML_BoardSpawner* Board,
 		EML_TileType GoalType,
@@ -79,4 +85,6 @@ public:
 
 private:
 	TWeakObjectPtr<AML_PlayerCharacter> BoundPlayer;
+	
+	FML_HexBFSScratch GoalScratch;
 };
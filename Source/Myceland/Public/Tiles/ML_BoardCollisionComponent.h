@@ -0,0 +1,59 @@
+﻿// Copyright Myceland Team, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Chaos/Convex.h"
+#include "Components/PrimitiveComponent.h"
+#include "ML_BoardCollisionComponent.generated.h"
+
+class UBodySetup;
+
+/**
+ * Collision of a set of board tiles in a single body: one hexagon prism element per tile of the set, all sharing one convex.
+ * A board uses two of them, the floor of every tile (all channels) and the prisms of its blocked tiles (pawns only).
+ * Traces hitting it resolve their tile with the axial math of the board (AML_BoardSpawner::GetTileAtLocation).
+ */
+UCLASS(ClassGroup=(Myceland))
+class MYCELAND_API UML_BoardCollisionComponent : public UPrimitiveComponent
+{
+	GENERATED_BODY()
+
+private:
+	UPROPERTY(Transient)
+	TObjectPtr<UBodySetup> BodySetup;
+
+	Chaos::FConvexPtr PrismConvex;
+
+	// Same points as the convex, for the element bounds
+	TArray<FVector> PrismVertices;
+
+	// By board index, relative to the component
+	TArray<FVector> TileCenters;
+	TBitArray<> EnabledTiles;
+	bool bPhysicsStateDirty = false;
+
+	static Chaos::FConvexPtr MakeHexPrism(float Radius, float AngleOffset, float Bottom, float Top, TArray<FVector>& OutVertices);
+
+public:
+	UML_BoardCollisionComponent();
+
+	// Shape of the prisms, read by Build
+	float PrismRadius = 100.f;
+	bool bFlatTop = true;
+	float PrismBottom = -10.f;
+	float PrismTop = 0.f;
+
+	// One element per enabled tile center (relative to the component), by board index
+	void Build(TConstArrayView<FVector> InTileCenters, const TBitArray<>& InEnabledTiles);
+
+	int32 GetNumTiles() const { return EnabledTiles.Num(); }
+
+	// Applied to the physics scene by CommitChanges
+	void SetTileEnabled(int32 Index, bool bEnabled);
+	void CommitChanges();
+
+	virtual UBodySetup* GetBodySetup() override { return BodySetup; }
+	virtual bool ShouldCreatePhysicsState() const override;
+	virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
+};
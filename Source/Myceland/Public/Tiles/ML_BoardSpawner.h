@@ -3,8 +3,11 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Core/ML_BoardLayout.h"
+#include "Core/ML_BoardState.h"
 #include "Core/ML_CoreData.h"
 #include "GameFramework/Actor.h"
+#include "Tiles/ML_BoardView.h"
 #include "ML_BoardSpawner.generated.h"
 
 class UML_BiomeTileSet;
@@ -14,6 +17,34 @@ class AML_TileWater;
 class AML_TileParasite;
 class AML_TileGrass;
 class AML_Tile;
+class UHierarchicalInstancedStaticMeshComponent;
+class UML_BoardCollisionComponent;
+
+// Instance of a tile in the instanced mesh of its type
+struct FML_TileInstance
+{
+	EML_TileType Type = EML_TileType::Dirt;
+	int32 Id = INDEX_NONE;
+};
+
+// Tile to spawn (Tile == nullptr) or to reattach while the grid is updated
+struct FML_PendingTile
+{
+	FIntPoint Axial = FIntPoint::ZeroValue;
+	TWeakObjectPtr<AML_Tile> Tile;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBoardReady, AML_BoardSpawner*, Board);
+
+USTRUCT()
+struct FML_TileVisualPool
+{
+	GENERATED_BODY()
+
+	// Hidden visuals ready to be reused
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AML_TileBase>> Free;
+};
 
 UCLASS()
 class MYCELAND_API AML_BoardSpawner : public AActor
@@ -38,15 +69,98 @@ private:
 	UPROPERTY(EditInstanceOnly, Category="Myceland Runtime")
 	AActor* AssociatedObstacle;
 	
+	// Hidden collectibles of the biome class added to the collectible pool when the board starts
+	UPROPERTY(EditInstanceOnly, Category="Myceland Runtime", meta=(ClampMin="0"))
+	int32 PrewarmCollectibles = 4;
+	
 	
+	// Dense tile storage, indexed by the board layout
 	UPROPERTY(Transient)
 	TArray<TObjectPtr<AML_Tile>> SpawnedTiles;
 	
-	TMap<FIntPoint, TObjectPtr<AML_Tile>> GridMap;
+	// Shared with the board state and its copies, replaced (never mutated) when the board is rebuilt
+	TSharedRef<const FML_BoardLayout> Layout = MakeShared<FML_BoardLayout>();
+	
+	// Authoritative actor-free state of the board, kept in sync by the tiles
+	FML_BoardState BoardState;
+	
+	// One instanced mesh per tile type when bUseInstancedRendering is set
+	UPROPERTY(Transient)
+	TMap<EML_TileType, TObjectPtr<UHierarchicalInstancedStaticMeshComponent>> TypeInstances;
+	
+	// Instances collapsed by a type change, reused before adding new ones (instance ids must stay stable)
+	TMap<EML_TileType, TArray<int32>> FreeInstances;
+	
+	// Indexed by board index
+	TArray<FML_TileInstance> TileInstances;
+	
+	// Visual actors in use, by tile (bPoolTileVisuals)
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<AML_Tile>, TObjectPtr<AML_TileBase>> TileVisuals;
+	
+	UPROPERTY(Transient)
+	TMap<TSubclassOf<AML_TileBase>, FML_TileVisualPool> VisualPools;
+	
+	// Grid update, shared by the synchronous and the time-sliced paths
+	void GatherPendingTiles(TArray<FML_PendingTile>& OutPending);
+	void ProcessPendingTile(const FML_PendingTile& Pending);
+	
+	// Time-sliced spawn (bAsyncSpawn)
+	TArray<FML_PendingTile> AsyncPendingTiles;
+	int32 AsyncPendingCursor = 0;
+	FTimerHandle AsyncSpawnTimerHandle;
+	bool bBoardReady = false;
+	
+	void BeginAsyncSpawn();
+	void ContinueAsyncSpawn();
+	void CancelAsyncSpawn();
+	FIntPoint GetAsyncSpawnFocus() const;
 	
 	// Generators
 	void SpawnHexagonRadius();
 	void SpawnRectangleWH();
+	
+	// Builds the dense layout from SpawnedTiles and reorders them by tile index
+	void BuildBoardLayout();
+	void ResetBoardLayout();
+	
+	// Tile visuals
+	void RebuildTileVisuals();
+	
+	// Instanced rendering
+	UHierarchicalInstancedStaticMeshComponent* GetOrCreateTypeInstances(EML_TileType Type);
+	void ReleaseTileInstance(FML_TileInstance& Instance);
+	bool UpdateTileInstance(const AML_Tile* Tile);
+	
+	// Visual pool
+	bool UsesVisualPool() const;
+	void PrewarmVisualPool();
+	AML_TileBase* SpawnPooledVisual(TSubclassOf<AML_TileBase> VisualClass);
+	AML_TileBase* AcquireVisual(TSubclassOf<AML_TileBase> VisualClass, AML_Tile* Tile);
+	void ReleaseVisual(AML_TileBase* Visual);
+	void DestroyVisualPool();
+	
+	// Deferred collision (bDeferTileCollision): board indices of the tiles whose blocked state changed since the last flush
+	TBitArray<> DirtyCollisionTiles;
+	
+	// Pooled visuals whose collision follows their visibility, the last request of the frame wins
+	TMap<TWeakObjectPtr<AML_TileBase>, bool> PendingVisualCollision;
+	FTimerHandle CollisionFlushTimerHandle;
+	
+	bool CanDeferCollision() const;
+	void RequestCollisionFlush();
+	void SetVisualCollision(AML_TileBase* Visual, bool bEnable);
+	
+	// Collision bodies of the board (bUseBoardCollision): the floor of every tile for all channels,
+	// and the prisms of the blocked tiles for pawns only, like the tile HexagonCollision
+	UPROPERTY(Transient)
+	TObjectPtr<UML_BoardCollisionComponent> BoardCollision;
+	
+	UPROPERTY(Transient)
+	TObjectPtr<UML_BoardCollisionComponent> BlockedCollision;
+	
+	UML_BoardCollisionComponent* CreateBoardCollisionComponent(bool bPawnOnly);
+	void RebuildBoardCollision();
 
 	// Conversions
 	FVector AxialToWorld(int32 Q, int32 R) const;
@@ -56,6 +170,11 @@ private:
 protected:
 	virtual void Destroyed() override;
 	virtual void BeginPlay() override;
+	virtual void PostRegisterAllComponents() override;
+	virtual void PostUnregisterAllComponents() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
 
 public:
 	// ==================== Myceland Hex Grid ====================
@@ -90,6 +209,56 @@ public:
 	UPROPERTY(EditAnywhere, Category="Myceland Hex Grid", meta=(ClampMin="0.01"))
 	FVector TileScale = FVector(2.f, 2.f, 2.f);
 	
+	// Draws Dirt/Grass/Parasite/Water tiles with one instanced mesh per type (ground mesh of the biome tile classes)
+	// instead of one child actor per tile. Other types keep their own visual.
+	UPROPERTY(EditAnywhere, Category="Myceland Hex Grid|Rendering")
+	bool bUseInstancedRendering = false;
+	
+	// At runtime, reuses hidden tile visual actors on type changes instead of respawning the tile child actor
+	UPROPERTY(EditAnywhere, Category="Myceland Hex Grid|Rendering", meta=(EditCondition="!bUseInstancedRendering"))
+	bool bPoolTileVisuals = false;
+	
+	// Hidden visuals spawned per biome tile class when the board starts
+	UPROPERTY(EditAnywhere, Category="Myceland Hex Grid|Rendering", meta=(ClampMin="0", EditCondition="bPoolTileVisuals && !bUseInstancedRendering"))
+	int32 PrewarmVisualsPerType = 8;
+	
+	// At runtime, queues the collision changes of the tiles and of their pooled visuals and applies them once per frame
+	// (or once per played wave step, see FlushTileCollision) instead of on every tile change
+	UPROPERTY(EditAnywhere, Category="Myceland Hex Grid|Collision")
+	bool bDeferTileCollision = true;
+	
+	// At runtime, replaces the two collision meshes of every tile (cursor/floor and blocked) by two bodies for the board:
+	// a floor prism per tile, and a taller prism per blocked tile updated on every collision flush
+	UPROPERTY(EditAnywhere, Category="Myceland Hex Grid|Collision")
+	bool bUseBoardCollision = false;
+	
+	// Top of the floor prisms, relative to the board
+	UPROPERTY(EditAnywhere, Category="Myceland Hex Grid|Collision", meta=(EditCondition="bUseBoardCollision"))
+	float BoardCollisionFloorHeight = 0.f;
+	
+	UPROPERTY(EditAnywhere, Category="Myceland Hex Grid|Collision", meta=(ClampMin="1.0", EditCondition="bUseBoardCollision"))
+	float BoardCollisionFloorThickness = 10.f;
+	
+	// Height of the blocked tile prisms above the floor
+	UPROPERTY(EditAnywhere, Category="Myceland Hex Grid|Collision", meta=(ClampMin="1.0", EditCondition="bUseBoardCollision"))
+	float BlockedCollisionHeight = 200.f;
+	
+	// Size of the blocked tile prisms relative to the tile (the tile HexagonCollision is 0.9)
+	UPROPERTY(EditAnywhere, Category="Myceland Hex Grid|Collision", meta=(ClampMin="0.1", ClampMax="1.0", EditCondition="bUseBoardCollision"))
+	float BlockedCollisionScale = 0.9f;
+	
+	// Spawns and initializes the tiles over several frames at BeginPlay, in rings around the player
+	UPROPERTY(EditAnywhere, Category="Myceland Hex Grid|Async Spawn")
+	bool bAsyncSpawn = false;
+	
+	// Game thread time spent on tiles per frame
+	UPROPERTY(EditAnywhere, Category="Myceland Hex Grid|Async Spawn", meta=(ClampMin="0.1", Units="ms", EditCondition="bAsyncSpawn"))
+	float AsyncSpawnBudgetMs = 2.f;
+	
+	// Broadcast every time the board layout is built, gameplay must wait for it (see IsBoardReady)
+	UPROPERTY(BlueprintAssignable, Category="Myceland Hex Grid")
+	FOnBoardReady OnBoardReady;
+	
 	
 	
 	UFUNCTION(CallInEditor, Category="Myceland Hex Grid", meta=(DisplayName="Update Current Grid"))
@@ -101,9 +270,43 @@ public:
 	UFUNCTION(CallInEditor, Category="Myceland Hex Grid", meta=(DisplayName="Clear Grid"))
 	void ClearTiles();
 	
+	UFUNCTION(BlueprintPure, Category="Myceland Hex Grid")
+	bool IsBoardReady() const { return bBoardReady; }
+	
 	UFUNCTION(BlueprintCallable, Category="Myceland Hex Grid")
 	TArray<AML_Tile*> GetNeighbors(AML_Tile* CenterTile);
 	
+	UFUNCTION(BlueprintPure, Category="Myceland Hex Grid")
+	AML_Tile* GetTileAt(const FIntPoint& Axial) const;
+	
+	// Tile whose hexagon contains WorldLocation on the board plane (height is ignored), nullptr off board
+	UFUNCTION(BlueprintPure, Category="Myceland Hex Grid")
+	AML_Tile* GetTileAtLocation(const FVector& WorldLocation) const;
+	
+	// Dense index of the tile on this board, INDEX_NONE if the tile does not belong to it
+	int32 GetTileIndex(const AML_Tile* Tile) const;
+	AML_Tile* GetTileByIndex(const int32 Index) const { return SpawnedTiles.IsValidIndex(Index) ? SpawnedTiles[Index].Get() : nullptr; }
+	const FML_BoardLayout& GetBoardLayout() const { return *Layout; }
+	
+	// Zero-copy access to the board, prefer it over GetGridMap/GetGridTiles in C++
+	FML_BoardView GetBoardView() const { return FML_BoardView(*Layout, SpawnedTiles); }
+	
+	// Tile types and flags without actors, copy it to simulate turns
+	const FML_BoardState& GetBoardState() const { return BoardState; }
+	
+	// Called by the tiles whenever their type or flags change
+	void SyncTileState(const AML_Tile* Tile);
+	
+	// Queues the collision of a tile whose blocked state changed. False if the tile must apply it right away.
+	bool DeferTileCollision(const AML_Tile* Tile);
+	
+	// Applies the queued collision changes, a collision setting changed back and forth since the last flush costs nothing
+	void FlushTileCollision();
+	
+	// Shows VisualClass on the tile through an instance or a pooled actor.
+	// Returns true if the board handles the tile visual, false if the tile must use its child actor.
+	bool UpdateTileVisual(AML_Tile* Tile, TSubclassOf<AML_TileBase> VisualClass);
+	
 	UFUNCTION(BlueprintPure, Category="Myceland Runtime")
 	TMap<FIntPoint, AML_Tile*> GetGridMap() const;
 	
@@ -0,0 +1,87 @@
+﻿// Copyright Myceland Team, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/ML_BoardLayout.h"
+
+class AML_Tile;
+
+/**
+ * Const, non-owning view over the tiles of a board.
+ * Iterating, looking up tiles and walking neighbors through the view never allocates.
+ * A view is only valid until its board is rebuilt, do not store it.
+ */
+class FML_BoardView
+{
+public:
+	// Iterates tiles as AML_Tile*
+	class FTileIterator
+	{
+	public:
+		explicit FTileIterator(const TObjectPtr<AML_Tile>* InPtr) : Ptr(InPtr) {}
+
+		AML_Tile* operator*() const { return Ptr->Get(); }
+		FTileIterator& operator++() { ++Ptr; return *this; }
+		bool operator!=(const FTileIterator& Other) const { return Ptr != Other.Ptr; }
+
+	private:
+		const TObjectPtr<AML_Tile>* Ptr;
+	};
+
+	// Iterates the 6 neighbor slots of a tile, yielding nullptr for off-board slots
+	class FNeighborIterator
+	{
+	public:
+		FNeighborIterator(const TConstArrayView<TObjectPtr<AML_Tile>> InTiles, const int32* InPtr) : Tiles(InTiles), Ptr(InPtr) {}
+
+		AML_Tile* operator*() const { return *Ptr != INDEX_NONE ? Tiles[*Ptr].Get() : nullptr; }
+		FNeighborIterator& operator++() { ++Ptr; return *this; }
+		bool operator!=(const FNeighborIterator& Other) const { return Ptr != Other.Ptr; }
+
+	private:
+		TConstArrayView<TObjectPtr<AML_Tile>> Tiles;
+		const int32* Ptr;
+	};
+
+	class FNeighborRange
+	{
+	public:
+		FNeighborRange(const TConstArrayView<TObjectPtr<AML_Tile>> InTiles, const TConstArrayView<int32> InIndices) : Tiles(InTiles), Indices(InIndices) {}
+
+		FNeighborIterator begin() const { return FNeighborIterator(Tiles, Indices.GetData()); }
+		FNeighborIterator end() const { return FNeighborIterator(Tiles, Indices.GetData() + Indices.Num()); }
+
+	private:
+		TConstArrayView<TObjectPtr<AML_Tile>> Tiles;
+		TConstArrayView<int32> Indices;
+	};
+
+	FML_BoardView() = default;
+	FML_BoardView(const FML_BoardLayout& InLayout, const TConstArrayView<TObjectPtr<AML_Tile>> InTiles) : Layout(&InLayout), Tiles(InTiles) {}
+
+	bool IsEmpty() const { return Tiles.Num() == 0; }
+	int32 Num() const { return Tiles.Num(); }
+	const FML_BoardLayout& GetLayout() const { check(Layout); return *Layout; }
+
+	AML_Tile* GetTile(const int32 Index) const { return Tiles.IsValidIndex(Index) ? Tiles[Index].Get() : nullptr; }
+	const FIntPoint& GetAxial(const int32 Index) const { return Layout->GetAxial(Index); }
+
+	int32 IndexOf(const FIntPoint& Axial) const { return Layout ? Layout->IndexOf(Axial) : INDEX_NONE; }
+	bool Contains(const FIntPoint& Axial) const { return IndexOf(Axial) != INDEX_NONE; }
+	AML_Tile* Find(const FIntPoint& Axial) const { return GetTile(IndexOf(Axial)); }
+
+	// Neighbors of the tile at Index (see AML_Tile::GetBoardIndex), empty when Index is not on the board
+	FNeighborRange Neighbors(const int32 Index) const
+	{
+		if (!Tiles.IsValidIndex(Index)) return FNeighborRange(Tiles, TConstArrayView<int32>());
+		return FNeighborRange(Tiles, Layout->GetNeighborIndices(Index));
+	}
+
+	FTileIterator begin() const { return FTileIterator(Tiles.GetData()); }
+	FTileIterator end() const { return FTileIterator(Tiles.GetData() + Tiles.Num()); }
+
+private:
+	const FML_BoardLayout* Layout = nullptr;
+	TConstArrayView<TObjectPtr<AML_Tile>> Tiles;
+};
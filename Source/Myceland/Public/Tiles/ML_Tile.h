@@ -48,6 +48,10 @@ private:
 	
 	UPROPERTY(VisibleAnywhere, Category="Myceland Tile")
 	FIntPoint AxialCoord = FIntPoint(0, 0);
+	
+	// Dense index in the owning board layout, rebuilt with the board
+	UPROPERTY(Transient, VisibleInstanceOnly, Category="Myceland Tile")
+	int32 BoardIndex = INDEX_NONE;
 
 	UPROPERTY(VisibleAnywhere, Category="Myceland Tile")
 	bool bBlocked = false;
@@ -55,8 +59,23 @@ private:
 	UPROPERTY(VisibleAnywhere, Category="Myceland Tile")
 	bool bHasCollectible = false;
 	
+	// Set when the tile went from Grass to Parasite, consumed by the collectible wave
+	bool bConsumedGrass = false;
+	
+	// The board collision bodies (AML_BoardSpawner::bUseBoardCollision) stand in for HighlightTileMesh and HexagonCollision
+	bool bUsesBoardCollision = false;
+	
 	void SetBlocked(bool bNewBlocked);
 	bool IsTileTypeBlocking(EML_TileType Type);
+	
+	// Mirrors the tile into the board state used by the waves
+	void SyncBoardState() const;
+	
+	// Shows NewClass as the tile visual, or lets the board draw it (instanced or pooled visuals)
+	void UpdateVisual(TSubclassOf<AML_TileBase> NewClass);
+	
+	// Class set on the tile for a type, nullptr if none
+	TSubclassOf<AML_TileBase> GetClassFieldForType(EML_TileType Type) const;
 
 protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Myceland Tile")
@@ -71,14 +90,16 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Myceland Tile")
 	UStaticMeshComponent* HexagonCollision;
 	
+	// Board registry (UML_BoardRegistrySubsystem)
+	virtual void PostRegisterAllComponents() override;
+	virtual void PostUnregisterAllComponents() override;
+	
 #if WITH_EDITOR
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
 	void UpdateClassInEditor(EML_TileType NewTileType);
 #endif
 
 public:
-	bool bConsumedGrass = false;
-	
 	AML_Tile();
 
 	UFUNCTION(BlueprintCallable, Category="Myceland Tile|Getter & Setter")
@@ -86,22 +107,42 @@ public:
 
 	UFUNCTION(BlueprintPure, Category="Myceland Tile|Getter & Setter")
 	FIntPoint GetAxialCoord() const { return AxialCoord; }
+	
+	void SetBoardIndex(const int32 InIndex) { BoardIndex = InIndex; }
+	int32 GetBoardIndex() const { return BoardIndex; }
 
 	UFUNCTION(BlueprintCallable, Category="Myceland Tile|Getter & Setter")
-	void SetCurrentType(const EML_TileType NewType) { CurrentType = NewType; }
+	void SetCurrentType(const EML_TileType NewType);
 
 	UFUNCTION(BlueprintPure, Category="Myceland Tile|Getter & Setter")
 	EML_TileType GetCurrentType() const { return CurrentType; }
 
 	UFUNCTION(BlueprintPure, Category="Myceland Tile|Getter & Setter")
 	bool IsBlocked() const { return bBlocked; }
+	
+	// Pawn collision matching bBlocked, applied by SetBlocked or by the board flush (AML_BoardSpawner::FlushTileCollision)
+	void ApplyBlockedCollision() const;
+	
+	void SetUsesBoardCollision(bool bNewValue);
+	
+	// Shows NewClass through TileChildActor, the child has no collision while the board collision stands in for it
+	void SetChildActorVisual(TSubclassOf<AML_TileBase> NewClass);
+	
+	// Visual of the current type: the class set on the tile, else the one of the board biome
+	TSubclassOf<AML_TileBase> GetTypeVisualClass() const;
+	
+	// Tile hit by a trace: the tile, one of its components or visuals, or the board collision body (tile under the hit point)
+	static AML_Tile* FromHitResult(const FHitResult& Hit);
 
 	UFUNCTION(BlueprintCallable, Category="Myceland Tile|Collectible")
-	void SetHasCollectible(const bool bNewValue) { bHasCollectible = bNewValue; }
+	void SetHasCollectible(const bool bNewValue);
 	
 	UFUNCTION(BlueprintPure, Category="Myceland Tile|Collectible")
 	bool HasCollectible() const { return bHasCollectible; }
 	
+	void SetConsumedGrass(const bool bNewValue);
+	bool HasConsumedGrass() const { return bConsumedGrass; }
+	
 	UFUNCTION(BlueprintPure, Category="Myceland Tile|Getter & Setter")
 	AML_BoardSpawner* GetBoardSpawnerFromTile() const { return Cast<AML_BoardSpawner>(GetOwner()); }
 
@@ -127,8 +168,9 @@ public:
 	void OnTileTypeChanged(EML_TileType OldType, EML_TileType NewType);
 	
 	
+	// bFireTileEvent false leaves the feedback to a batched event (UML_WavePropagationSubsystem::OnWaveStepApplied)
 	UFUNCTION()
-	void UpdateClassAtRuntime(const EML_TileType NewTileType, TSubclassOf<AML_TileBase> NewClass);
+	void UpdateClassAtRuntime(const EML_TileType NewTileType, TSubclassOf<AML_TileBase> NewClass, bool bFireTileEvent = true);
 	
 	UFUNCTION()
 	void Initialize(UML_BiomeTileSet* InBiomeTileSet);
@@ -25,4 +25,6 @@ protected:
 
 public:
 	virtual void Tick(float DeltaTime) override;
+	
+	UStaticMeshComponent* GetGroundBase() const { return GroundBase; }
 };
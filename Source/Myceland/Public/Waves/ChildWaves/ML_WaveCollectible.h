@@ -12,5 +12,8 @@ class MYCELAND_API UML_WaveCollectible : public UML_PropagationWaves
 	GENERATED_BODY()
 	
 public:
-	virtual void ComputeWaveForCollectibles(AML_Tile* OriginTile, const TArray<AML_Tile*>& ParasitesThatAteGrass, TArray<FML_WaveChange>& OutChanges) override;
+	virtual void ComputeCollectiblesOnState(const FML_BoardState& State, int32 OriginIndex, TConstArrayView<int32> ParasitesThatAteGrass, FML_BoardChangeBuckets& OutChanges) const override;
+	
+	// Spawns next to the parasites of the context, then consumes them
+	virtual void Execute(FML_WaveContext& Context, FML_BoardChangeBuckets& OutChanges) const override;
 };
@@ -0,0 +1,25 @@
+﻿// Copyright Myceland Team, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Waves/ML_PropagationWaves.h"
+#include "ML_WaveRuleTable.generated.h"
+
+class UML_WaveRuleSet;
+
+// Wave whose spread is the rules of a UML_WaveRuleSet instead of C++
+UCLASS()
+class MYCELAND_API UML_WaveRuleTable : public UML_PropagationWaves
+{
+	GENERATED_BODY()
+
+protected:
+	UPROPERTY(EditDefaultsOnly, Category="Rules")
+	UML_WaveRuleSet* RuleSet = nullptr;
+
+public:
+	virtual void ComputeWaveOnState(const FML_BoardState& State, int32 OriginIndex, FML_BoardChangeBuckets& OutChanges) const override;
+	virtual void Execute(FML_WaveContext& Context, FML_BoardChangeBuckets& OutChanges) const override;
+	virtual TSharedPtr<const FML_CompiledWaveRules, ESPMode::ThreadSafe> GetCompiledRules() const override;
+};
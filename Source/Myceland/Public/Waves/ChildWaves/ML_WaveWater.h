@@ -12,5 +12,6 @@ class MYCELAND_API UML_WaveWater : public UML_PropagationWaves
 	GENERATED_BODY()
 	
 public:
-	virtual void ComputeWave(AML_Tile* OriginTile, TArray<FML_WaveChange>& OutChanges) override;
+	virtual void ComputeWaveOnState(const FML_BoardState& State, int32 OriginIndex, FML_BoardChangeBuckets& OutChanges) const override;
+	virtual void ComputeWaveOnChangedState(const FML_BoardState& State, int32 OriginIndex, TConstArrayView<int32> ChangedTiles, FML_BoardChangeBuckets& OutChanges) const override;
 };
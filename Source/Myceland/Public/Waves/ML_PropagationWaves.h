@@ -7,7 +7,10 @@
 #include "UObject/Object.h"
 #include "ML_PropagationWaves.generated.h"
 
-class AML_Tile;
+struct FML_BoardState;
+struct FML_BoardChangeBuckets;
+struct FML_WaveContext;
+struct FML_CompiledWaveRules;
 
 UCLASS(Abstract, Blueprintable, EditInlineNew, DefaultToInstanced)
 class MYCELAND_API UML_PropagationWaves : public UObject
@@ -15,6 +18,17 @@ class MYCELAND_API UML_PropagationWaves : public UObject
 	GENERATED_BODY()
 	
 public:
-	virtual void ComputeWave(AML_Tile* OriginTile, TArray<FML_WaveChange>& OutChanges) PURE_VIRTUAL(UML_PropagationWaves::ComputeWave, ); // leave ", " because it signifies the void return type
-	virtual void ComputeWaveForCollectibles(AML_Tile* OriginTile, const TArray<AML_Tile*>& ParasitesThatAteGrass, TArray<FML_WaveChange>& OutChanges) PURE_VIRTUAL(UML_PropagationWaves::ComputeWaveForCollectibles, ); // leave ", " because it signifies the void return type
+	// Actor-free wave logic, OriginIndex is the board index of the tile that started the turn
+	virtual void ComputeWaveOnState(const FML_BoardState& State, int32 OriginIndex, FML_BoardChangeBuckets& OutChanges) const PURE_VIRTUAL(UML_PropagationWaves::ComputeWaveOnState, ); // leave ", " because it signifies the void return type
+	virtual void ComputeCollectiblesOnState(const FML_BoardState& State, int32 OriginIndex, TConstArrayView<int32> ParasitesThatAteGrass, FML_BoardChangeBuckets& OutChanges) const PURE_VIRTUAL(UML_PropagationWaves::ComputeCollectiblesOnState, ); // leave ", " because it signifies the void return type
+	
+	// Same result as ComputeWaveOnState, knowing that only ChangedTiles changed since this wave last ran on the board
+	// (its changes applied). Waves whose result depends on distant tiles keep the full computation.
+	virtual void ComputeWaveOnChangedState(const FML_BoardState& State, int32 OriginIndex, TConstArrayView<int32> ChangedTiles, FML_BoardChangeBuckets& OutChanges) const { ComputeWaveOnState(State, OriginIndex, OutChanges); }
+	
+	// Pipeline entry point (FML_WavePipeline), picks the computation from what the context knows
+	virtual void Execute(FML_WaveContext& Context, FML_BoardChangeBuckets& OutChanges) const;
+
+	// Data rules the wave runs, taken by FML_WavePipeline::Snapshot for resolves on worker threads. Null for C++ waves.
+	virtual TSharedPtr<const FML_CompiledWaveRules, ESPMode::ThreadSafe> GetCompiledRules() const { return nullptr; }
 };
@@ -0,0 +1,73 @@
+﻿// Copyright Myceland Team, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/SubclassOf.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class UML_PropagationWaves;
+struct FML_BoardState;
+struct FML_CompiledWaveRules;
+
+// Everything a wave may read when it runs. Waves take what they need and ignore the rest.
+struct FML_WaveContext
+{
+	const FML_BoardState& State;
+
+	// Board index of the tile that started the turn
+	int32 OriginIndex = INDEX_NONE;
+
+	// Tiles changed since this wave last ran on the board (its changes applied), unset when unknown
+	TOptional<TConstArrayView<int32>> ChangedTiles;
+
+	// Parasites that ate grass since the last collectible wave, emptied by the wave that consumes them
+	TArray<int32>& ParasitesThatAteGrass;
+
+	// Rules of a data driven wave as they were when the pipeline was snapshot, null to read them from the wave
+	const FML_CompiledWaveRules* Rules = nullptr;
+
+	FML_WaveContext(const FML_BoardState& InState, const int32 InOriginIndex, TArray<int32>& InParasitesThatAteGrass)
+		: State(InState), OriginIndex(InOriginIndex), ParasitesThatAteGrass(InParasitesThatAteGrass) {}
+};
+
+struct FML_WaveStage
+{
+	// Class default object. Weak: reinstancing a wave class (live coding, blueprint compile) replaces it,
+	// the owner compiles the pipeline again and a stale stage is skipped meanwhile.
+	TWeakObjectPtr<const UML_PropagationWaves> Wave;
+
+	// Index in UML_MycelandDeveloperSettings::WavesPriority
+	int32 PriorityIndex = INDEX_NONE;
+
+	// UML_PropagationWaves::GetCompiledRules, only set in a snapshot
+	TSharedPtr<const FML_CompiledWaveRules, ESPMode::ThreadSafe> Rules;
+};
+
+/**
+ * WavesPriority compiled once: one stage per configured wave, in priority order, unset entries dropped.
+ * A cycle is a walk over the stages calling UML_PropagationWaves::Execute, whatever the wave type.
+ */
+struct MYCELAND_API FML_WavePipeline
+{
+	static FML_WavePipeline Compile(TConstArrayView<TSubclassOf<UML_PropagationWaves>> WavesPriority);
+
+	// Copy for a worker thread, call on the game thread: waves with data rules keep the rules they have now
+	FML_WavePipeline Snapshot() const;
+
+	// Combined FML_CompiledWaveRules::GetVersion of the current rules of the stages, 0 without data rules.
+	// Changes when a rule set is edited or a wave points to another one.
+	uint32 GetRulesVersion() const;
+
+	TConstArrayView<FML_WaveStage> GetStages() const { return Stages; }
+
+	// Every stage still has its wave
+	bool IsValid() const;
+
+	// Object is the wave or the wave class of a stage
+	bool UsesWave(const UObject* Object) const;
+	int32 Num() const { return Stages.Num(); }
+
+private:
+	TArray<FML_WaveStage> Stages;
+};
@@ -0,0 +1,41 @@
+﻿// Copyright Myceland Team, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Clock of the wave playback: a queue of entries, each one due a delay after the previous one.
+ * The owner advances it once per frame and plays every entry due in that frame as one batch.
+ */
+struct MYCELAND_API FML_WavePlaybackScheduler
+{
+	// Slowest playback allowed: at 0 the clock would never reach the next entry and the turn would never end
+	static constexpr float MinTimeScale = 0.01f;
+
+	// Global speed of the playback, at least MinTimeScale
+	float TimeScale = 1.f;
+
+	// Extra speed while bFastForward is set
+	float FastForwardScale = 4.f;
+	bool bFastForward = false;
+
+	// Starts a new playback, drops what was left of the previous one.
+	// Delays are in seconds, each relative to the previous entry.
+	void Begin(TArray<float>&& InDelays);
+	void Stop();
+
+	bool IsPlaying() const { return NextEntry < Delays.Num(); }
+
+	// Releases every remaining entry on the next Advance, whatever the clock
+	void FlushAll() { bFlushAll = true; }
+
+	// Moves the clock by DeltaTime (scaled). Returns how many entries are due, starting at OutFirstEntry.
+	int32 Advance(float DeltaTime, int32& OutFirstEntry);
+
+private:
+	TArray<float> Delays;
+	int32 NextEntry = 0;
+	float Clock = 0.f;
+	bool bFlushAll = false;
+};
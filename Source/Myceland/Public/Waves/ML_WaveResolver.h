@@ -0,0 +1,88 @@
+﻿// Copyright Myceland Team, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/ML_BoardState.h"
+
+#include <atomic>
+
+struct FML_WavePipeline;
+
+// Changes of one wave applied at one distance, the unit of wave playback
+struct FML_WaveTimelineStep
+{
+	// Index of the wave in UML_MycelandDeveloperSettings::WavesPriority
+	int32 PriorityIndex = INDEX_NONE;
+	int32 DistanceFromOrigin = 0;
+
+	// First step of a wave run: played after InterWaveDelay instead of IntraWaveDelay
+	bool bStartsWave = false;
+
+	// Range of the step in FML_WaveTimeline::Changes
+	int32 FirstChange = 0;
+	int32 NumChanges = 0;
+};
+
+// Whole outcome of a turn, known before anything is played
+struct FML_WaveTimeline
+{
+	TArray<FML_WaveTimelineStep> Steps;
+
+	// Changes of every step back to back, in playback order
+	TArray<FML_BoardChange> Changes;
+
+	TConstArrayView<FML_BoardChange> GetChanges(const FML_WaveTimelineStep& Step) const { return MakeArrayView(Changes.GetData() + Step.FirstChange, Step.NumChanges); }
+
+	// Board once every step is applied
+	FML_BoardState FinalState;
+
+	// Some change turned the player tile into a deadly tile
+	bool bPlayerKilled = false;
+
+	// The cycle kept changing the board and was cut (see FML_WaveResolveParams::MaxCycles)
+	bool bReachedCycleLimit = false;
+
+	// A cycle ended on a board already seen at the end of an earlier cycle: the rules oscillate, the turn was cut there
+	bool bDetectedLoop = false;
+
+	// FML_WaveResolveParams::CancelFlag was raised, the timeline is incomplete
+	bool bCancelled = false;
+	int32 LoopStartCycle = INDEX_NONE;
+	int32 LoopEndCycle = INDEX_NONE;
+
+	// Per pipeline stage: ran at least once, its journal serial then is in FML_WaveResolveParams::WaveSerials
+	TBitArray<> RanWaves;
+};
+
+struct FML_WaveResolveParams
+{
+	int32 OriginIndex = INDEX_NONE;
+
+	// Board index of the player tile, INDEX_NONE if the player is not on the board
+	int32 PlayerIndex = INDEX_NONE;
+
+	// Waves to run, compiled from WavesPriority
+	const FML_WavePipeline* Pipeline = nullptr;
+
+	// Per pipeline stage, journal serial of its last run on the board (FML_BoardState::GetChangeSerial), 0 when unknown.
+	// Updated by the resolve for the waves that ran.
+	TArray<uint32> WaveSerials;
+
+	// Checked before every wave, lets another thread drop a resolve in flight (plant preview)
+	const std::atomic<bool>* CancelFlag = nullptr;
+
+	// Backstop for loops the board hash cannot see
+	int32 MaxCycles = 64;
+};
+
+/**
+ * Runs the wave cycle of a turn to its end on a copy of the board, with the rules of the animated cycle:
+ * waves run in priority order, a wave without changes ends the turn, any change restarts the cycle once it completes.
+ * A cycle ending on a board state (FML_BoardState::GetHash) seen at the end of an earlier cycle would repeat forever, the turn ends there.
+ * The actor layer only plays the resulting timeline.
+ */
+struct MYCELAND_API FML_WaveResolver
+{
+	static void Resolve(const FML_BoardState& InitialState, FML_WaveResolveParams& Params, FML_WaveTimeline& OutTimeline);
+};